@@ -40,15 +40,39 @@ ubyte g3_code_point(g3s_point &p)
 
 }
 
-//rotates a point. returns codes.  does not check if already rotated
-ubyte g3_rotate_point(g3s_point &dest,const vms_vector &src)
+//same arithmetic as vm_vec_dot, inlined so the rotation loops below do
+//not call out of this file for each component
+static inline fix g3_rotate_dot(const vms_vector &v, const vms_vector &m)
 {
-	const auto tempv = vm_vec_sub(src,View_position);
-	vm_vec_rotate(dest.p3_vec,tempv,View_matrix);
+	return (static_cast<int64_t>(v.x) * m.x + static_cast<int64_t>(v.y) * m.y + static_cast<int64_t>(v.z) * m.z) >> 16;
+}
+
+static inline ubyte g3_rotate_point(g3s_point &dest, const vms_vector &src, const vms_vector &view_position, const vms_matrix &view_matrix)
+{
+	const auto tempv = vm_vec_sub(src, view_position);
+	dest.p3_x = g3_rotate_dot(tempv, view_matrix.rvec);
+	dest.p3_y = g3_rotate_dot(tempv, view_matrix.uvec);
+	dest.p3_z = g3_rotate_dot(tempv, view_matrix.fvec);
 	dest.p3_flags = 0;	//no projected
 	return g3_code_point(dest);
 }
 
+//rotates a point. returns codes.  does not check if already rotated
+ubyte g3_rotate_point(g3s_point &dest,const vms_vector &src)
+{
+	return g3_rotate_point(dest, src, View_position, View_matrix);
+}
+
+void g3_rotate_point_list(g3s_point *dest, const vms_vector *src, std::size_t n)
+{
+	//local copies, so that the stores to dest do not force the view
+	//to be reloaded for every point
+	const auto view_position = View_position;
+	const auto view_matrix = View_matrix;
+	for (; n; --n)
+		g3_rotate_point(*dest++, *src++, view_position, view_matrix);
+}
+
 //checks for overflow & divides if ok, fillig in r
 //returns true if div is ok, else false
 int checkmuldiv(fix *r,fix a,fix b,fix c)
@@ -12,7 +12,9 @@
  *  -- MD2211 (2006-04-24)
  */
 
+#include <map>
 #include <memory>
+#include <string>
 #include <SDL.h>
 #include <SDL_mixer.h>
 #include <string.h>
@@ -69,6 +71,12 @@ public:
 static current_music_t current_music;
 static std::vector<uint8_t> current_music_hndlbuf;
 
+/* HMP songs already converted to MIDI, so that returning to a song does
+ * not convert it again.  Missions may replace the stock songs under the
+ * same names, so the key includes where the file was found.
+ */
+static std::map<std::string, std::vector<uint8_t>> converted_hmp_songs;
+
 /*
  *  Plays a music file from an absolute path or a relative path
  */
@@ -90,9 +98,17 @@ int mix_play_file(const char *filename, int loop, void (*hook_finished_track)())
 	// It's a .hmp!
 	if (!d_stricmp(fptr, ".hmp"))
 	{
-		hmp2mid(filename, current_music_hndlbuf);
-		rw = SDL_RWFromConstMem(&current_music_hndlbuf[0], current_music_hndlbuf.size()*sizeof(char));
-		current_music.reset(Mix_LoadMUS_RW(rw), rw);
+		const char *const realdir = PHYSFS_getRealDir(filename);
+		auto &midbuf = realdir
+			? converted_hmp_songs[std::string(realdir) + '/' + filename]
+			: current_music_hndlbuf;
+		if (midbuf.empty() || !realdir)
+			hmp2mid(filename, midbuf);
+		if (!midbuf.empty())
+		{
+			rw = SDL_RWFromConstMem(&midbuf[0], midbuf.size()*sizeof(char));
+			current_music.reset(Mix_LoadMUS_RW(rw), rw);
+		}
 	}
 
 	// try loading music via given filename
@@ -169,6 +169,10 @@ static inline g3s_point g3_rotate_point(const vms_vector &src)
 	return g3_rotate_point(dest, src), dest;
 }
 
+//rotates n points from src into dest, with the same results as calling
+//g3_rotate_point on each.  does not check if already rotated
+void g3_rotate_point_list(g3s_point *dest, const vms_vector *src, std::size_t n);
+
 //projects a point
 void g3_project_point(g3s_point &point);
 
@@ -188,12 +192,15 @@ ubyte g3_add_delta_vec(g3s_point &dest,const g3s_point &src,const vms_vector &de
 
 //Drawing functions:
 
+constexpr std::size_t MAX_POINTS_PER_POLY = 25;
+
 //draw a flat-shaded face.
 //returns 1 if off screen, 0 if drew
 void _g3_draw_poly(uint_fast32_t nv,cg3s_point *const *pointlist, uint8_t color);
 template <std::size_t N>
 static inline void g3_draw_poly(uint_fast32_t nv, const array<cg3s_point *, N> &pointlist, const uint8_t color)
 {
+	static_assert(N <= MAX_POINTS_PER_POLY, "too many points in poly");
 	_g3_draw_poly(nv, &pointlist[0], color);
 }
 
@@ -203,8 +210,6 @@ static inline void g3_draw_poly(const array<cg3s_point *, N> &pointlist, const u
 	g3_draw_poly(N, pointlist, color);
 }
 
-constexpr std::size_t MAX_POINTS_PER_POLY = 25;
-
 //draw a texture-mapped face.
 //returns 1 if off screen, 0 if drew
 void _g3_draw_tmap(unsigned nv, cg3s_point *const *pointlist, const g3s_uvl *uvl_list, const g3s_lrgb *light_rgb, grs_bitmap &bm);
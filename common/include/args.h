@@ -112,6 +112,7 @@ struct CArg : prohibit_void_ptr<CArg>
 	bool DbgNoDoubleBuffer;
 	bool DbgNoCompressPigBitmap;
 	bool DbgRenderStats;
+	unsigned DbgSimBenchmarkTicks;
 	uint8_t DbgBpp;
 	int8_t DbgVerbose;
 	bool SysNoNiceFPS;
@@ -126,7 +127,12 @@ struct CArg : prohibit_void_ptr<CArg>
 	std::string SysHogDir;
 	std::string SysPilot;
 	std::string SysRecordDemoNameTemplate;
+	std::string SysTimeDemo;
 	std::string MplUdpHostAddr;
+#if DXX_USE_UDP
+	std::string DbgUdpTrafficLog;
+	std::string DbgUdpCapture;
+#endif
 	std::string DbgAltTex;
 	std::string DbgTexMap;
 };
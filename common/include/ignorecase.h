@@ -82,6 +82,17 @@ namespace dcx {
  */
 int PHYSFSEXT_locateCorrectCase(char *buf);
 
+/**
+ * \fn void PHYSFSEXT_invalidateCorrectCase()
+ * \brief Forget all cached directory listings.
+ *
+ * PHYSFSEXT_locateCorrectCase remembers the entries of each directory it
+ *  had to scan.  Call this after changing the search path or creating
+ *  files, so that new entries can be found.  The PHYSFSX_ wrappers for
+ *  those calls already do.
+ */
+void PHYSFSEXT_invalidateCorrectCase();
+
 /* end of ignorecase.h ... */
 
 }
@@ -453,6 +453,14 @@ static inline int PHYSFSX_checkMatchingExtension(const array<file_extension_t, c
 	return PHYSFSX_checkMatchingExtension(filename, exts);
 }
 
+/* These wrap the PhysFS calls which can make a name appear, and discard
+ * the directories cached by PHYSFSEXT_locateCorrectCase.  Use them instead
+ * of the PHYSFS_ originals.
+ */
+int PHYSFSX_addToSearchPath(const char *newDir, int appendToPath);
+int PHYSFSX_removeFromSearchPath(const char *oldDir);
+int PHYSFSX_mkdir(const char *dirName);
+RAIIPHYSFS_File PHYSFSX_openWrite(const char *filename);
 extern int PHYSFSX_addRelToSearchPath(const char *relname, int add_to_end);
 extern int PHYSFSX_removeRelFromSearchPath(const char *relname);
 extern int PHYSFSX_fsize(const char *hogname);
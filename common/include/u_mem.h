@@ -43,6 +43,8 @@ namespace dcx {
 void mem_init(void);
 
 void mem_display_blocks();
+// Reports per-call-site allocation growth since the previous call
+void mem_display_sites();
 __attribute_alloc_size(1)
 __attribute_malloc()
 void *mem_malloc(size_t size, const char *var, const char *file, unsigned line);
@@ -455,6 +455,18 @@ static void cmd_wait(unsigned long argc, const char *const *const argv)
 		cmd_queue_wait = atoi(argv[1]);
 }
 
+#ifdef DEBUG_MEMORY_ALLOCATIONS
+/* report allocation growth by call site */
+static void cmd_memsites(unsigned long argc, const char *const *const argv)
+{
+	if (argc > 1) {
+		cmd_insertf("help %s", argv[0]);
+		return;
+	}
+	mem_display_sites();
+}
+#endif
+
 void cmd_init(void)
 {
 	cmd_addcommand("alias",     cmd_alias,      "alias <name> <commands>\n" "    define <name> as an alias for <commands>\n"
@@ -465,4 +477,7 @@ void cmd_init(void)
 	cmd_addcommand("exec",      cmd_exec,       "exec <file>\n"             "    execute <file>");
 	cmd_addcommand("help",      cmd_help,       "help [command]\n"          "    get help for <command>, or list all commands if not specified.");
 	cmd_addcommand("wait",      cmd_wait,       "usage: wait [n]\n"         "    stop processing commands, resume in <n> cycles (default 1)");
+#ifdef DEBUG_MEMORY_ALLOCATIONS
+	cmd_addcommand("memsites",  cmd_memsites,   "memsites\n"                "    show allocation growth by call site since the last report");
+#endif
 }
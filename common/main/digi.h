@@ -94,6 +94,10 @@ int digi_start_sound(short soundnum, fix volume, int pan, int looping, int loop_
 // Stops all sounds that are playing
 void digi_stop_all_channels();
 
+// Prepare a sound for playback ahead of its first use.
+void digi_preload_sound(short soundnum);
+void digi_preload_level_sounds();
+
 void digi_stop_digi_sounds();
 
 extern void digi_end_sound( int channel );
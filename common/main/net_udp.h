@@ -66,6 +66,7 @@ constexpr uint16_t TRACKER_PORT_DEFAULT = 9999;
 #define UDP_MDATA_STOR_MIN_FREE_2JOIN 384 // have at least this many free packet slots before we let someone join the game
 #define UDP_MDATA_PKT_NUM_MIN 1 // start from pkt_num 1 (0 is used to initialize the trace list)
 #define UDP_MDATA_PKT_NUM_MAX (UDP_MDATA_STOR_QUEUE_SIZE*100) // the max value for pkt_num. roll over when we go any higher. this should be smaller than INT_MAX
+#define UDP_OBJ_PACKETS_PER_FRAME 8 // Send up to this many UPID_OBJECT_DATA packets per object sync tick
 
 // UDP-Packet identificators (ubyte) and their (max. sizes).
 #define UPID_VERSION_DENY			  1 // Netgame join or info has been denied due to version difference.
@@ -88,8 +88,11 @@ cobjptridx_t newdemo_find_object(object_signature_t signature);
 void newdemo_record_kill_sound_linked_to_object(vcobjptridx_t);
 namespace dsx {
 void newdemo_start_playback(const char *filename);
+void newdemo_start_timedemo(const char *filename);
 }
 #endif
+bool newdemo_timedemo_active();
+fix newdemo_timedemo_frame(fix elapsed);
 extern void newdemo_record_sound_3d_once( int soundno, int angle, int volume );
 extern void newdemo_record_sound_once( int soundno );
 extern void newdemo_record_sound( int soundno );
@@ -0,0 +1,313 @@
+/*
+ * This file is part of the DXX-Rebirth project <http://www.dxx-rebirth.com/>.
+ * It is copyright by its individual contributors, as recorded in the
+ * project's Git history.  See COPYING.txt at the top level for license
+ * terms and a link to the Git history.
+ */
+
+/*
+ *
+ * Determinism check and timing for the fixed-point maths library.
+ * Built only when SCons is given mathbench=1.
+ *
+ * Every case feeds a fixed pseudo-random input sequence through one
+ * function and hashes the results.  With the default iteration count,
+ * the hash is compared against the value recorded below, so a change
+ * that alters any result of any case is reported.  Game state,
+ * including demos and netgames, depends on these results, so they must
+ * not change.
+ *
+ */
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include "maths.h"
+#include "vecmat.h"
+
+#include "compiler-range_for.h"
+
+namespace dcx {
+
+namespace {
+
+#define MATHBENCH_DEFAULT_ITERATIONS	(1u << 22)
+
+class bench_state
+{
+	uint64_t seed = UINT64_C(0x9e3779b97f4a7c15);
+public:
+	uint64_t hash = UINT64_C(0xcbf29ce484222325);
+	uint32_t next()
+	{
+		//	xorshift64*, which is fast and identical on every platform
+		seed ^= seed >> 12;
+		seed ^= seed << 25;
+		seed ^= seed >> 27;
+		return static_cast<uint32_t>((seed * UINT64_C(0x2545f4914f6cdd1d)) >> 32);
+	}
+	//	Uniform in [-range, range)
+	fix next_fix(const fix range)
+	{
+		return static_cast<fix>(next() % (2 * static_cast<uint32_t>(range))) - range;
+	}
+	vms_vector next_vector(const fix range)
+	{
+		vms_vector v;
+		v.x = next_fix(range);
+		v.y = next_fix(range);
+		v.z = next_fix(range);
+		return v;
+	}
+	vms_angvec next_angvec()
+	{
+		vms_angvec a;
+		a.p = static_cast<fixang>(next());
+		a.b = static_cast<fixang>(next());
+		a.h = static_cast<fixang>(next());
+		return a;
+	}
+	void mix(const uint64_t v)
+	{
+		hash = (hash ^ v) * UINT64_C(0x100000001b3);
+	}
+	void mix(const vms_vector &v)
+	{
+		mix(static_cast<uint32_t>(v.x));
+		mix(static_cast<uint32_t>(v.y));
+		mix(static_cast<uint32_t>(v.z));
+	}
+	void mix(const vms_angvec &a)
+	{
+		mix(static_cast<uint16_t>(a.p) | (static_cast<uint16_t>(a.b) << 16) | (static_cast<uint64_t>(static_cast<uint16_t>(a.h)) << 32));
+	}
+	void mix(const vms_matrix &m)
+	{
+		mix(m.rvec);
+		mix(m.uvec);
+		mix(m.fvec);
+	}
+};
+
+//	World coordinates stay well inside this, and it keeps every
+//	intermediate product of the vector routines inside 64 bits.
+#define VECTOR_RANGE	(F1_0 << 12)
+
+static void bench_baseline(bench_state &s)
+{
+	const uint32_t a = s.next();
+	s.mix(a ^ s.next());
+}
+
+static void bench_fixmul64(bench_state &s)
+{
+	const fix a = s.next();
+	s.mix(fixmul64(a, s.next()));
+}
+
+static void bench_fixdiv(bench_state &s)
+{
+	const fix a = s.next(), b = s.next();
+	s.mix(static_cast<uint32_t>(fixdiv(a, b >> (s.next() & 15))));
+}
+
+static void bench_fixmuldiv(bench_state &s)
+{
+	const fix a = s.next(), b = s.next();
+	s.mix(static_cast<uint32_t>(fixmuldiv(a, b, s.next())));
+}
+
+static void bench_long_sqrt(bench_state &s)
+{
+	const uint32_t a = s.next();
+	s.mix(long_sqrt(a >> (s.next() & 31)));
+}
+
+static void bench_quad_sqrt(bench_state &s)
+{
+	const uint64_t high = s.next(), low = s.next();
+	quadint q;
+	q.q = static_cast<int64_t>((high << 32 | low) >> (1 + s.next() % 63));
+	s.mix(quad_sqrt(q));
+}
+
+static void bench_fix_sqrt(bench_state &s)
+{
+	const uint32_t a = s.next();
+	s.mix(static_cast<uint32_t>(fix_sqrt(a >> (s.next() & 31))));
+}
+
+static void bench_fix_sincos(bench_state &s)
+{
+	const auto r = fix_sincos(s.next());
+	s.mix(static_cast<uint32_t>(r.sin) | static_cast<uint64_t>(static_cast<uint32_t>(r.cos)) << 32);
+}
+
+static void bench_fix_fastsin(bench_state &s)
+{
+	s.mix(static_cast<uint32_t>(fix_fastsin(s.next())));
+}
+
+static void bench_fix_asin(bench_state &s)
+{
+	s.mix(static_cast<uint16_t>(fix_asin(s.next_fix(F1_0 + F1_0 / 8))));
+}
+
+static void bench_fix_acos(bench_state &s)
+{
+	s.mix(static_cast<uint16_t>(fix_acos(s.next_fix(F1_0 + F1_0 / 8))));
+}
+
+static void bench_fix_atan2(bench_state &s)
+{
+	const fix c = s.next_fix(1 << 30);
+	s.mix(static_cast<uint16_t>(fix_atan2(c, s.next_fix(1 << 30))));
+}
+
+static void bench_vm_vec_dot(bench_state &s)
+{
+	const auto a = s.next_vector(VECTOR_RANGE);
+	s.mix(static_cast<uint32_t>(vm_vec_dot(a, s.next_vector(F1_0))));
+}
+
+static void bench_vm_vec_mag(bench_state &s)
+{
+	s.mix(static_cast<uint32_t>(static_cast<fix>(vm_vec_mag(s.next_vector(VECTOR_RANGE)))));
+}
+
+static void bench_vm_vec_mag_quick(bench_state &s)
+{
+	s.mix(static_cast<uint32_t>(static_cast<fix>(vm_vec_mag_quick(s.next_vector(VECTOR_RANGE)))));
+}
+
+static void bench_vm_vec_normalize(bench_state &s)
+{
+	auto v = s.next_vector(VECTOR_RANGE);
+	vm_vec_normalize(v);
+	s.mix(v);
+}
+
+static void bench_vm_vec_normalize_quick(bench_state &s)
+{
+	auto v = s.next_vector(VECTOR_RANGE);
+	vm_vec_normalize_quick(v);
+	s.mix(v);
+}
+
+static void bench_vm_vec_cross(bench_state &s)
+{
+	const auto a = s.next_vector(VECTOR_RANGE);
+	s.mix(vm_vec_cross(a, s.next_vector(VECTOR_RANGE)));
+}
+
+static void bench_vm_vec_normal(bench_state &s)
+{
+	const auto a = s.next_vector(VECTOR_RANGE), b = s.next_vector(VECTOR_RANGE);
+	s.mix(vm_vec_normal(a, b, s.next_vector(VECTOR_RANGE)));
+}
+
+static void bench_vm_vec_delta_ang(bench_state &s)
+{
+	const auto a = vm_vec_normalized(s.next_vector(F1_0)), b = vm_vec_normalized(s.next_vector(F1_0));
+	s.mix(static_cast<uint16_t>(vm_vec_delta_ang(a, b, s.next_vector(F1_0))));
+}
+
+static void bench_vm_angles_2_matrix(bench_state &s)
+{
+	s.mix(vm_angles_2_matrix(s.next_angvec()));
+}
+
+static void bench_vm_vector_2_matrix(bench_state &s)
+{
+	const auto f = s.next_vector(VECTOR_RANGE), u = s.next_vector(VECTOR_RANGE);
+	s.mix(vm_vector_2_matrix(f, (s.next() & 1) ? &u : nullptr, nullptr));
+}
+
+static void bench_vm_vec_rotate(bench_state &s)
+{
+	const auto m = vm_angles_2_matrix(s.next_angvec());
+	s.mix(vm_vec_rotate(s.next_vector(VECTOR_RANGE), m));
+}
+
+static void bench_vm_extract_angles_matrix(bench_state &s)
+{
+	s.mix(vm_extract_angles_matrix(vm_angles_2_matrix(s.next_angvec())));
+}
+
+struct bench_case
+{
+	const char *name;
+	void (*run)(bench_state &);
+	uint64_t golden;	// hash after MATHBENCH_DEFAULT_ITERATIONS calls
+};
+
+const bench_case bench_cases[] = {
+	{"baseline", bench_baseline, UINT64_C(0x8c975fe706019066)},
+	{"fixmul64", bench_fixmul64, UINT64_C(0x3d86b68d4c12862b)},
+	{"fixdiv", bench_fixdiv, UINT64_C(0xce42580b92d7a60c)},
+	{"fixmuldiv", bench_fixmuldiv, UINT64_C(0x75e5f18d652450f0)},
+	{"long_sqrt", bench_long_sqrt, UINT64_C(0x11fc82129f410896)},
+	{"quad_sqrt", bench_quad_sqrt, UINT64_C(0xed52a062c228f0d9)},
+	{"fix_sqrt", bench_fix_sqrt, UINT64_C(0x33e44df4bcb30425)},
+	{"fix_sincos", bench_fix_sincos, UINT64_C(0xffdbe11a20959e31)},
+	{"fix_fastsin", bench_fix_fastsin, UINT64_C(0x4ef3547e0ad58ab1)},
+	{"fix_asin", bench_fix_asin, UINT64_C(0x08431fef496310b0)},
+	{"fix_acos", bench_fix_acos, UINT64_C(0xb2740be2d6f55cdf)},
+	{"fix_atan2", bench_fix_atan2, UINT64_C(0x56f0bfb045a22a4d)},
+	{"vm_vec_dot", bench_vm_vec_dot, UINT64_C(0xe4b2dbb5e4048483)},
+	{"vm_vec_mag", bench_vm_vec_mag, UINT64_C(0xa950e0c97f42b10d)},
+	{"vm_vec_mag_quick", bench_vm_vec_mag_quick, UINT64_C(0xbc6aedaad1a84b90)},
+	{"vm_vec_normalize", bench_vm_vec_normalize, UINT64_C(0xd67ab5bb3873b965)},
+	{"vm_vec_normalize_quick", bench_vm_vec_normalize_quick, UINT64_C(0x858a92465e1010d6)},
+	{"vm_vec_cross", bench_vm_vec_cross, UINT64_C(0xa86b9e3c62736ce3)},
+	{"vm_vec_normal", bench_vm_vec_normal, UINT64_C(0x530f206e23be6abc)},
+	{"vm_vec_delta_ang", bench_vm_vec_delta_ang, UINT64_C(0x208e24f7f992ac37)},
+	{"vm_angles_2_matrix", bench_vm_angles_2_matrix, UINT64_C(0xad2593baf79f0922)},
+	{"vm_vector_2_matrix", bench_vm_vector_2_matrix, UINT64_C(0x6b55df4d11a5f7e9)},
+	{"vm_vec_rotate", bench_vm_vec_rotate, UINT64_C(0x39930c088cf4b09f)},
+	{"vm_extract_angles_matrix", bench_vm_extract_angles_matrix, UINT64_C(0xe4e9e77d0f356aa2)},
+};
+
+}
+
+}
+
+int main(int argc, char **argv)
+{
+	using namespace std::chrono;
+	const unsigned long iterations = argc > 1 ? strtoul(argv[1], nullptr, 0) : MATHBENCH_DEFAULT_ITERATIONS;
+	const bool check = (iterations == MATHBENCH_DEFAULT_ITERATIONS);
+	unsigned failures = 0;
+	printf("%-26s %10s %10s  %-16s\n", "case", "calls", "ns/call", "hash");
+	range_for (auto &c, dcx::bench_cases)
+	{
+		dcx::bench_state s;
+		const auto start = steady_clock::now();
+		for (unsigned long i = iterations; i; --i)
+			c.run(s);
+		const auto elapsed = duration_cast<duration<double, std::nano>>(steady_clock::now() - start).count();
+		const char *status = "";
+		if (check)
+		{
+			if (s.hash == c.golden)
+				status = "ok";
+			else
+			{
+				status = "MISMATCH";
+				++failures;
+			}
+		}
+		printf("%-26s %10lu %10.2f  %016" PRIx64 "  %s\n", c.name, iterations, iterations ? elapsed / iterations : 0., s.hash, status);
+	}
+	/* Times include generating the inputs and hashing the results, which
+	 * is what the baseline case measures on its own.
+	 */
+	if (!check)
+		printf("Hashes are only checked with the default of %u iterations.\n", MATHBENCH_DEFAULT_ITERATIONS);
+	else if (failures)
+		printf("%u cases do not match the recorded results.\n", failures);
+	return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -27,13 +27,15 @@ COPYRIGHT 1993-1999 PARALLAX SOFTWARE CORPORATION.  ALL RIGHTS RESERVED.
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unordered_map>
+#include <utility>
 #include "pstypes.h"
 #include "dxxerror.h"
 #include "args.h"
 #include "console.h"
 #include "u_mem.h"
 
-#include "compiler-array.h"
+#include "compiler-range_for.h"
 
 namespace dcx {
 
@@ -46,54 +48,82 @@ namespace dcx {
 #define CHECKSIZE 16
 #define CHECKBYTE 0xFC
 
-#define MAX_INDEX 10000
+/* Each live block is found by address, so that freeing a block costs a
+ * hash lookup instead of a scan of every allocation made so far.
+ */
+struct mem_block
+{
+	size_t size;
+	const char *var;
+	const char *filename;
+	unsigned line;
+};
+
+/* Allocation statistics for one MALLOC call site.  `snapshot_bytes` is
+ * the value of `live_bytes` when mem_display_sites last ran, so that
+ * repeated calls report only the growth since the previous call.
+ */
+struct mem_site
+{
+	const char *var;
+	unsigned long allocations, frees;
+	size_t live_bytes, peak_bytes, snapshot_bytes;
+};
 
-static array<void *, MAX_INDEX> MallocBase;
-static array<unsigned int, MAX_INDEX> MallocSize;
-static array<unsigned char, MAX_INDEX> Present;
-static array<const char *, MAX_INDEX> Filename;
-static array<const char *, MAX_INDEX> Varname;
-static array<int, MAX_INDEX> LineNum;
-static int BytesMalloced = 0;
+struct mem_site_key_hash
+{
+	size_t operator()(const std::pair<const char *, unsigned> &k) const
+	{
+		return std::hash<const char *>()(k.first) ^ (static_cast<size_t>(k.second) * 0x9e3779b9u);
+	}
+};
+
+struct mem_tables
+{
+	std::unordered_map<void *, mem_block> blocks;
+	std::unordered_map<std::pair<const char *, unsigned>, mem_site, mem_site_key_hash> sites;
+};
 
-static int free_list[MAX_INDEX];
+/* The tables are never destroyed, so that blocks freed by static
+ * destructors after main returns can still be found.
+ */
+static mem_tables &get_mem_tables()
+{
+	static mem_tables *const t = new mem_tables;
+	return *t;
+}
 
-static int num_blocks = 0;
+static size_t BytesMalloced = 0;
 
 static int Initialized = 0;
-static int LargestIndex = 0;
 static int out_of_memory = 0;
 
 void mem_init()
 {
 	Initialized = 1;
 
-	MallocBase = {};
-	MallocSize = {};
-	Present = {};
-	Filename = {};
-	Varname = {};
-	LineNum = {};
-	for (int i=0; i<MAX_INDEX; i++ )
-	{
-		free_list[i] = i;
-	}
-
-	num_blocks = 0;
-	LargestIndex = 0;
+	auto &t = get_mem_tables();
+	t.blocks.clear();
+	t.sites.clear();
+	BytesMalloced = 0;
 
 	atexit(mem_display_blocks);
 }
 
-static void PrintInfo( int id )
+static void PrintInfo(const mem_block &b)
 {
-	con_printf(CON_CRITICAL, "\tBlock '%s' created in %s, line %d.", Varname[id], Filename[id], LineNum[id] );
+	con_printf(CON_CRITICAL, "\tBlock '%s' created in %s, line %u.", b.var, b.filename, b.line);
 }
 
+static mem_site &mem_find_site(const mem_block &b)
+{
+	auto &s = get_mem_tables().sites[std::make_pair(b.filename, b.line)];
+	s.var = b.var;
+	return s;
+}
 
 void *mem_malloc(size_t size, const char * var, const char * filename, unsigned line)
 {
-	int id;
 	void *ptr;
 	char * pc;
 
@@ -116,38 +146,24 @@ void *mem_malloc(size_t size, const char * var, const char * filename, unsigned
 	}
 #endif	// end of ifdef memstats
 
-	if ( num_blocks >= MAX_INDEX )	{
-		con_printf(CON_CRITICAL,"\nMEM_OUT_OF_SLOTS: Not enough space in mem.c to hold all the mallocs." );		
-		con_printf(CON_CRITICAL, "\tBlock '%s' created in %s, line %d.", var, filename, line );
-		Error( "MEM_OUT_OF_SLOTS" );
-	}
-
-	id = free_list[ num_blocks++ ];
-
-	if (id > LargestIndex ) LargestIndex = id;
-
-	if (id==-1)
-	{
-		con_printf(CON_CRITICAL,"\nMEM_OUT_OF_SLOTS: Not enough space in mem.c to hold all the mallocs." );		
-		//con_printf(CON_CRITICAL, "\tBlock '%s' created in %s, line %d.", Varname[id], Filename[id], LineNum[id] );
-		Error( "MEM_OUT_OF_SLOTS" );
-	}
 	ptr = malloc(size + DXX_DEBUG_BIAS_MEMORY_ALLOCATION + CHECKSIZE);
 
 	if (ptr==NULL)
 	{
 		out_of_memory = 1;
 		con_printf(CON_CRITICAL, "\nMEM_OUT_OF_MEMORY: Malloc returned NULL" );
-		con_printf(CON_CRITICAL, "\tBlock '%s' created in %s, line %d.", Varname[id], Filename[id], LineNum[id] );
+		con_printf(CON_CRITICAL, "\tBlock '%s' created in %s, line %u.", var, filename, line);
 		Error( "MEM_OUT_OF_MEMORY" );
 	}
 	ptr = reinterpret_cast<char *>(ptr) + DXX_DEBUG_BIAS_MEMORY_ALLOCATION;
-	MallocBase[id] = ptr;
-	MallocSize[id] = size;
-	Varname[id] = var;
-	Filename[id] = filename;
-	LineNum[id] = line;
-	Present[id]    = 1;
+	const mem_block b{size, var, filename, line};
+	get_mem_tables().blocks[ptr] = b;
+
+	auto &s = mem_find_site(b);
+	++s.allocations;
+	s.live_bytes += size;
+	if (s.peak_bytes < s.live_bytes)
+		s.peak_bytes = s.live_bytes;
 
 	pc = reinterpret_cast<char *>(ptr);
 
@@ -174,23 +190,12 @@ void *(mem_calloc)( size_t nmemb, size_t size, const char * var, const char * fi
 	return ptr;
 }
 
-static int mem_find_id( void * buffer )
-{
-	for (int i=0; i<=LargestIndex; i++ )
-	  if (Present[i]==1)
-	    if (MallocBase[i] == buffer )
-	      return i;
-
-	// Didn't find id.
-	return -1;
-}
-
-static int mem_check_integrity( int block_number )
+static int mem_check_integrity(void *const buffer, const mem_block &b)
 {
 	int ErrorCount;
 	uint8_t * CheckData;
 
-	CheckData = reinterpret_cast<uint8_t *>(reinterpret_cast<char *>(MallocBase[block_number]) + MallocSize[block_number]);
+	CheckData = reinterpret_cast<uint8_t *>(buffer) + b.size;
 
 	ErrorCount = 0;
 			
@@ -202,7 +207,7 @@ static int mem_check_integrity( int block_number )
 
 	if (ErrorCount &&  (!out_of_memory))	{
 		con_printf(CON_CRITICAL, "\nMEM_OVERWRITE: Memory after the end of allocated block overwritten." );
-		PrintInfo( block_number );
+		PrintInfo(b);
 		con_printf(CON_CRITICAL, "\t%d/%d check bytes were overwritten.", ErrorCount, CHECKSIZE );
 		Int3();
 	}
@@ -213,8 +218,6 @@ static int mem_check_integrity( int block_number )
 
 void mem_free( void * buffer )
 {
-	int id;
-
 	if (Initialized==0)
 		mem_init();
 
@@ -239,34 +242,38 @@ void mem_free( void * buffer )
 		Int3();
 		return;
 	}
-	id = mem_find_id( buffer );
+	auto &blocks = get_mem_tables().blocks;
+	const auto i = blocks.find(buffer);
 
-	if (id==-1 &&  (!out_of_memory))
+	if (i == blocks.end())
 	{
-		con_printf(CON_CRITICAL, "\nMEM_FREE_NOMALLOC: An attempt was made to free a ptr that wasn't\nallocated with mem.h included." );
-		Warning( "MEM: Freeing a non-malloced pointer!" );
-		Int3();
+		if (!out_of_memory)
+		{
+			con_printf(CON_CRITICAL, "\nMEM_FREE_NOMALLOC: An attempt was made to free a ptr that wasn't\nallocated with mem.h included." );
+			Warning( "MEM: Freeing a non-malloced pointer!" );
+			Int3();
+		}
 		return;
 	}
 	
-	mem_check_integrity( id );
+	const auto &b = i->second;
+	mem_check_integrity(buffer, b);
 	
-	BytesMalloced -= MallocSize[id];
+	BytesMalloced -= b.size;
 
-	buffer = reinterpret_cast<char *>(buffer) - DXX_DEBUG_BIAS_MEMORY_ALLOCATION;
-	free( buffer );
+	auto &s = mem_find_site(b);
+	++s.frees;
+	s.live_bytes -= b.size;
 
-	Present[id] = 0;
-	MallocBase[id] = 0;
-	MallocSize[id] = 0;
+	blocks.erase(i);
 
-	free_list[ --num_blocks ] = id;
+	buffer = reinterpret_cast<char *>(buffer) - DXX_DEBUG_BIAS_MEMORY_ALLOCATION;
+	free( buffer );
 }
 
 void *mem_realloc(void *buffer, size_t size, const char *var, const char *filename, unsigned line)
 {
 	void *newbuffer;
-	int id;
 
 	if (Initialized==0)
 		mem_init();
@@ -279,9 +286,10 @@ void *mem_realloc(void *buffer, size_t size, const char *var, const char *filena
 	} else {
 		newbuffer = mem_malloc(size, var, filename, line);
 		if (newbuffer != NULL) {
-			id = mem_find_id(buffer);
-			if (MallocSize[id] < size)
-				size = MallocSize[id];
+			auto &blocks = get_mem_tables().blocks;
+			const auto i = blocks.find(buffer);
+			if (i != blocks.end() && i->second.size < size)
+				size = i->second.size;
 			memcpy(newbuffer, buffer, size);
 			mem_free(buffer);
 		}
@@ -289,9 +297,26 @@ void *mem_realloc(void *buffer, size_t size, const char *var, const char *filena
 	return newbuffer;
 }
 
+void mem_display_sites()
+{
+	if (Initialized==0) return;
+
+	con_printf(CON_NORMAL, "MEM_SITES: %" DXX_PRI_size_type " bytes in %" DXX_PRI_size_type " blocks allocated", BytesMalloced, get_mem_tables().blocks.size());
+	range_for (auto &i, get_mem_tables().sites)
+	{
+		auto &s = i.second;
+		if (s.live_bytes == s.snapshot_bytes)
+			continue;
+		const bool grew = s.live_bytes > s.snapshot_bytes;
+		const size_t change = grew ? s.live_bytes - s.snapshot_bytes : s.snapshot_bytes - s.live_bytes;
+		s.snapshot_bytes = s.live_bytes;
+		con_printf(CON_NORMAL, "\t%s:%u '%s': %c%" DXX_PRI_size_type " bytes, %" DXX_PRI_size_type " live, %" DXX_PRI_size_type " peak, %lu allocs, %lu frees", i.first.first, i.first.second, s.var, grew ? '+' : '-', change, s.live_bytes, s.peak_bytes, s.allocations, s.frees);
+	}
+}
+
 void mem_display_blocks()
 {
-	int numleft;
+	size_t numleft;
 
 	if (Initialized==0) return;
 	
@@ -311,31 +336,30 @@ void mem_display_blocks()
 	}
 #endif	// end of ifdef memstats
 
-	numleft = 0;
-	for (int i=0; i<=LargestIndex; i++ )
+	if (out_of_memory)
+		return;
+	numleft = get_mem_tables().blocks.size();
+	if (CGameArg.DbgShowMemInfo)
 	{
-		if (Present[i]==1 &&  (!out_of_memory))
+		range_for (auto &i, get_mem_tables().blocks)
 		{
-			numleft++;
-			if (CGameArg.DbgShowMemInfo)	{
-				con_printf(CON_CRITICAL, "\nMEM_LEAKAGE: Memory block has not been freed." );
-				PrintInfo( i );
-			}
+			con_printf(CON_CRITICAL, "\nMEM_LEAKAGE: Memory block has not been freed." );
+			PrintInfo(i.second);
 		}
+		mem_display_sites();
 	}
 
-	if (numleft &&  (!out_of_memory))
+	if (numleft)
 	{
-		Warning( "MEM: %d blocks were left allocated!\n", numleft );
+		Warning("MEM: %" DXX_PRI_size_type " blocks were left allocated!\n", numleft);
 	}
 
 }
 
 void mem_validate_heap()
 {
-	for (int i=0; i<LargestIndex; i++  )
-		if (Present[i]==1 )
-			mem_check_integrity( i );
+	range_for (auto &i, get_mem_tables().blocks)
+		mem_check_integrity(i.first, i.second);
 }
 
 #else
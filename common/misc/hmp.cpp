@@ -703,11 +703,21 @@ void hmp2mid(const char *hmp_name, std::vector<uint8_t> &midbuf)
 {
 	std::unique_ptr<hmp_file> hmp = hmp_open(hmp_name);
 	if (!hmp)
+	{
+		midbuf.clear();
 		return;
+	}
 
 	const midhdr mh(hmp.get());
 	// write MIDI-header
 	midbuf.resize(serial::message_type<decltype(mh)>::maximum_size);
+	{
+		// MIDI tracks come out about the size of the HMP tracks
+		std::size_t expected = midbuf.size();
+		for (int i = 1; i < hmp->num_trks; i++)
+			expected += track_header.size() + hmp->trks[i].len;
+		midbuf.reserve(expected);
+	}
 	be_bytebuffer_t bb(&midbuf[0]);
 	serial::process_buffer(bb, mh);
 
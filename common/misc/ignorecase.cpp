@@ -10,6 +10,8 @@
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <string>
+#include <unordered_map>
 
 #include "physfsx.h"
 #include "physfs_list.h"
@@ -71,25 +73,81 @@ public:
 
 }
 
+/* Directories which needed a case-insensitive scan, mapped from the
+ * case-folded name of each entry to its real name.  Lookups against a
+ * mounted HOG tend to repeat, so the directory is enumerated once and
+ * then served from here.  A name absent from a cached directory is
+ * reported missing without another scan, so repeated probes for
+ * optional files stay cheap.  A cached name which no longer exists
+ * causes one fresh scan.  PHYSFSEXT_invalidateCorrectCase drops
+ * everything when the search path changes or a file is created.
+ */
+typedef std::unordered_map<std::string, std::string> folded_directory_t;
+static std::unordered_map<std::string, folded_directory_t> folded_directory_cache;
+
+//	Beyond this, the cache is discarded rather than grown
+#define MAX_FOLDED_DIRECTORIES	64
+
+static std::string fold_case(const char *s)
+{
+	std::string r(s);
+	range_for (auto &c, r)
+		c = toupper(static_cast<int>(c));
+	return r;
+}
+
+static void enumerate_folded_directory(folded_directory_t &dir, char *const ptr, const char *const buf)
+{
+	search_result_t rc{ptr, buf};
+	dir.clear();
+	range_for (const auto i, rc)
+		dir.emplace(fold_case(i), i);
+}
+
 static int locateOneElement(char *const sptr, char *const ptr, const char *buf)
 {
     if (PHYSFS_exists(buf))
         return(1);  /* quick rejection: exists in current case. */
 
-	search_result_t rc{ptr, buf};
-	range_for (const auto i, rc)
-    {
-		if (caseInsensitiveStringCompare(i, sptr) == 0)
-        {
-			strcpy(sptr, i); /* found a match. Overwrite with this case. */
-            return(1);
-        } /* if */
-    } /* for */
+	const auto folded = fold_case(sptr);
+	auto key = ptr ? std::string(buf, ptr - buf) : std::string("/");
+	auto d = folded_directory_cache.find(key);
+	if (d == folded_directory_cache.end())
+	{
+		if (folded_directory_cache.size() >= MAX_FOLDED_DIRECTORIES)
+			folded_directory_cache.clear();
+		d = folded_directory_cache.emplace(std::move(key), folded_directory_t()).first;
+		enumerate_folded_directory(d->second, ptr, buf);
+	}
+	else
+	{
+		auto &dir = d->second;
+		const auto &&f = dir.find(folded);
+		if (f == dir.end())
+			return(0);	/* not present when the directory was scanned */
+		auto candidate = std::string(buf, sptr - buf);
+		candidate += f->second;
+		if (!PHYSFS_exists(candidate.c_str()))
+			/* stale: the entry went away, so scan again */
+			enumerate_folded_directory(dir, ptr, buf);
+	}
+	auto &dir = d->second;
+	const auto &&f = dir.find(folded);
+	if (f != dir.end())
+	{
+		strcpy(sptr, f->second.c_str()); /* found a match. Overwrite with this case. */
+		return(1);
+	}
 
     /* no match at all... */
     return(0);
 } /* locateOneElement */
 
+void PHYSFSEXT_invalidateCorrectCase()
+{
+	folded_directory_cache.clear();
+}
+
 
 int PHYSFSEXT_locateCorrectCase(char *buf)
 {
@@ -194,7 +194,7 @@ static window_event_result browser_handler(UI_DIALOG *const dlg, const d_event &
 			}
 			
 			// File doesn't exist, but can we create it?
-			if (RAIIPHYSFS_File TempFile{PHYSFS_openWrite(b->filename)})
+			if (auto TempFile = PHYSFSX_openWrite(b->filename))
 			{
 				TempFile.reset();
 				// Looks like a valid filename!
@@ -15,6 +15,7 @@
 
 #include "dxxsconf.h"
 #include "compiler-array.h"
+#include "compiler-integer_sequence.h"
 
 static void dispatchDecoder(unsigned char **pFrame, unsigned char codeType, const unsigned char **pData, int *pDataRemain, int *curXb, int *curYb);
 
@@ -47,29 +48,110 @@ void decodeFrame8(unsigned char *pFrame, const unsigned char *pMap, int mapRemai
 	}
 }
 
-static void relClose(int i, int *x, int *y)
+namespace {
+
+struct position_t
 {
-	int ma, mi;
+	int x, y;
+};
 
-	ma = i >> 4;
-	mi = i & 0xf;
+static inline constexpr position_t relClose(int i)
+{
+	return {(i & 0xf) - 8, (i >> 4) - 8};
+}
 
-	*x = mi - 8;
-	*y = ma - 8;
+static inline constexpr position_t relFar0(int i, int sign)
+{
+	return {
+		sign * (8 + (i % 7)),
+		sign *      (i / 7)
+	};
 }
 
-static void relFar(int i, int sign, int *x, int *y)
+static inline constexpr position_t relFar56(int i, int sign)
 {
-	if (i < 56)
-	{
-		*x = sign * (8 + (i % 7));
-		*y = sign *      (i / 7);
-	}
-	else
-	{
-		*x = sign * (-14 + (i - 56) % 29);
-		*y = sign *   (8 + (i - 56) / 29);
-	}
+	return {
+		sign * (-14 + (i - 56) % 29),
+		sign *   (8 + (i - 56) / 29)
+	};
+}
+
+static inline constexpr position_t relFar(int i, int sign)
+{
+	return (i < 56) ? relFar0(i, sign) : relFar56(i, sign);
+}
+
+/* For each 8 bit pattern, a byte per pixel which is 0xff where the
+ * pattern bit is set, so that two colour rows can be built a whole row at
+ * a time instead of testing each bit.
+ */
+using pixel_mask_t = array<uint8_t, 8>;
+
+static inline constexpr uint8_t pixelMaskBit(unsigned pat, unsigned bit)
+{
+	return (pat & (1 << bit)) ? 0xff : 0;
+}
+
+static inline constexpr pixel_mask_t pixelMask(unsigned pat)
+{
+	return {{
+		pixelMaskBit(pat, 0), pixelMaskBit(pat, 1), pixelMaskBit(pat, 2), pixelMaskBit(pat, 3),
+		pixelMaskBit(pat, 4), pixelMaskBit(pat, 5), pixelMaskBit(pat, 6), pixelMaskBit(pat, 7)
+	}};
+}
+
+//	Doubles each of the low four bits, for patterns of 2 pixel wide boxes
+static inline constexpr unsigned doubleBits(unsigned pat)
+{
+	return ((pat & 1) ? 0x03 : 0) | ((pat & 2) ? 0x0c : 0) | ((pat & 4) ? 0x30 : 0) | ((pat & 8) ? 0xc0 : 0);
+}
+
+struct lookup_table_t
+{
+	array<position_t, 256> close, far_p, far_n;
+	array<pixel_mask_t, 256> mask;
+	array<uint8_t, 16> doubled;
+};
+
+template <std::size_t... N>
+static inline constexpr lookup_table_t genLookupTable(index_sequence<N...>)
+{
+	return lookup_table_t{
+		{{relClose(N)...}},
+		{{relFar(N, 1)...}},
+		{{relFar(N, -1)...}},
+		{{pixelMask(N)...}},
+		{{
+			doubleBits(0), doubleBits(1), doubleBits(2), doubleBits(3),
+			doubleBits(4), doubleBits(5), doubleBits(6), doubleBits(7),
+			doubleBits(8), doubleBits(9), doubleBits(10), doubleBits(11),
+			doubleBits(12), doubleBits(13), doubleBits(14), doubleBits(15)
+		}}
+	};
+}
+
+constexpr lookup_table_t lookup_table = genLookupTable(make_tree_index_sequence<256>());
+
+}
+
+/* Selects p0 or p1 for each pixel of a row, according to the pattern
+ * mask.  Every operation works on each byte separately, so the result
+ * does not depend on byte order.
+ */
+static inline uint64_t selectRow8(uint8_t p0, uint8_t p1, unsigned pat)
+{
+	const uint64_t splat = UINT64_C(0x0101010101010101);
+	uint64_t mask;
+	memcpy(&mask, &lookup_table.mask[pat], sizeof(mask));
+	return (p0 * splat) ^ ((p0 ^ p1) * splat & mask);
+}
+
+static inline uint32_t selectRow4(uint8_t p0, uint8_t p1, unsigned pat)
+{
+	const uint32_t splat = 0x01010101;
+	uint32_t mask;
+	memcpy(&mask, &lookup_table.mask[pat], sizeof(mask));
+	return (p0 * splat) ^ ((p0 ^ p1) * splat & mask);
 }
 
 /* copies an 8x8 block from pSrc to pDest.
@@ -90,16 +172,10 @@ static void patternRow4Pixels(unsigned char *pFrame,
 							  unsigned char pat0, unsigned char pat1,
 							  const array<uint8_t, 4> &p)
 {
-	unsigned short mask=0x0003;
-	unsigned short shift=0;
-	unsigned short pattern = (pat1 << 8) | pat0;
+	unsigned pattern = (pat1 << 8) | pat0;
 
-	while (mask != 0)
-	{
-		*pFrame++ = p[(mask & pattern) >> shift];
-		mask <<= 2;
-		shift += 2;
-	}
+	for (int i=0; i<8; i++, pattern >>= 2)
+		pFrame[i] = p[pattern & 3];
 }
 
 // Fill in the next four 2x2 pixel blocks with p[0], p[1], p[2], or p[3],
@@ -108,111 +184,68 @@ static void patternRow4Pixels2(unsigned char *pFrame,
 							   unsigned char pat0,
 							   const array<uint8_t, 4> &p)
 {
-	unsigned char mask=0x03;
-	unsigned char shift=0;
-	unsigned char pel;
+	array<uint8_t, 8> row;
+	unsigned pattern = pat0;
 
-	while (mask != 0)
-	{
-		pel = p[(mask & pat0) >> shift];
-		pFrame[0] = pel;
-		pFrame[1] = pel;
-		pFrame[g_width + 0] = pel;
-		pFrame[g_width + 1] = pel;
-		pFrame += 2;
-		mask <<= 2;
-		shift += 2;
-	}
+	for (int i=0; i<8; i += 2, pattern >>= 2)
+		row[i] = row[i + 1] = p[pattern & 3];
+	memcpy(pFrame, row.data(), row.size());
+	memcpy(pFrame + g_width, row.data(), row.size());
 }
 
 // Fill in the next four 2x1 pixel blocks with p[0], p[1], p[2], or p[3],
 // depending on the corresponding two-bit value in pat.
 static void patternRow4Pixels2x1(unsigned char *pFrame, unsigned char pat, const array<uint8_t, 4> &p)
 {
-	unsigned char mask=0x03;
-	unsigned char shift=0;
-	unsigned char pel;
+	unsigned pattern = pat;
 
-	while (mask != 0)
-	{
-		pel = p[(mask & pat) >> shift];
-		pFrame[0] = pel;
-		pFrame[1] = pel;
-		pFrame += 2;
-		mask <<= 2;
-		shift += 2;
-	}
+	for (int i=0; i<8; i += 2, pattern >>= 2)
+		pFrame[i] = pFrame[i + 1] = p[pattern & 3];
 }
 
 // Fill in the next 4x4 pixel block with p[0], p[1], p[2], or p[3],
 // depending on the corresponding two-bit value in pat0, pat1, pat2, and pat3.
 static void patternQuadrant4Pixels(unsigned char *pFrame, unsigned char pat0, unsigned char pat1, unsigned char pat2, unsigned char pat3, const array<uint8_t, 4> &p)
 {
-	unsigned long mask = 0x00000003UL;
-	int shift=0;
-	unsigned long pat = (pat3 << 24) | (pat2 << 16) | (pat1 << 8) | pat0;
+	const array<uint8_t, 4> pats{{pat0, pat1, pat2, pat3}};
 
-	for (int i=0; i<16; i++)
+	for (int i=0; i<4; i++, pFrame += g_width)
 	{
-		pFrame[i&3] = p[(pat & mask) >> shift];
-
-		if ((i&3) == 3)
-			pFrame += g_width;
-
-		mask <<= 2;
-		shift += 2;
+		const unsigned pattern = pats[i];
+		pFrame[0] = p[pattern & 3];
+		pFrame[1] = p[(pattern >> 2) & 3];
+		pFrame[2] = p[(pattern >> 4) & 3];
+		pFrame[3] = p[pattern >> 6];
 	}
 }
 
 // fills the next 8 pixels with either p[0] or p[1], depending on pattern
 static void patternRow2Pixels(unsigned char *pFrame, unsigned char pat, const array<uint8_t, 4> &p)
 {
-	unsigned char mask=0x01;
-
-	while (mask != 0)
-	{
-		*pFrame++ = p[(mask & pat) ? 1 : 0];
-		mask <<= 1;
-	}
+	const auto row = selectRow8(p[0], p[1], pat);
+	memcpy(pFrame, &row, sizeof(row));
 }
 
 // fills the next four 2 x 2 pixel boxes with either p[0] or p[1], depending on pattern
 static void patternRow2Pixels2(unsigned char *pFrame, unsigned char pat, const array<uint8_t, 4> &p)
 {
-	unsigned char pel;
-	unsigned char mask=0x1;
-
-	while (mask != 0x10)
-	{
-		pel = p[(mask & pat) ? 1 : 0];
-
-		pFrame[0] = pel;              // upper-left
-		pFrame[1] = pel;              // upper-right
-		pFrame[g_width + 0] = pel;    // lower-left
-		pFrame[g_width + 1] = pel;    // lower-right
-		pFrame += 2;
-
-		mask <<= 1;
-	}
+	const auto row = selectRow8(p[0], p[1], lookup_table.doubled[pat & 0xf]);
+	memcpy(pFrame, &row, sizeof(row));              // upper row
+	memcpy(pFrame + g_width, &row, sizeof(row));    // lower row
 }
 
 // fills pixels in the next 4 x 4 pixel boxes with either p[0] or p[1], depending on pat0 and pat1.
 static void patternQuadrant2Pixels(unsigned char *pFrame, unsigned char pat0, unsigned char pat1, const array<uint8_t, 4> &p)
 {
-	unsigned char pel;
-	unsigned short mask = 0x0001;
-	unsigned short pat = (pat1 << 8) | pat0;
+	const array<uint8_t, 4> rows{{
+		static_cast<uint8_t>(pat0 & 0xf), static_cast<uint8_t>(pat0 >> 4),
+		static_cast<uint8_t>(pat1 & 0xf), static_cast<uint8_t>(pat1 >> 4)
+	}};
 
 	for (int i=0; i<4; i++)
 	{
-		for (int j=0; j<4; j++)
-		{
-			pel = p[(pat & mask) ? 1 : 0];
-
-			pFrame[j + i * g_width] = pel;
-
-			mask <<= 1;
-		}
+		const auto row = selectRow4(p[0], p[1], rows[i]);
+		memcpy(pFrame + i * g_width, &row, sizeof(row));
 	}
 }
 
@@ -249,7 +282,11 @@ static void dispatchDecoder(unsigned char **pFrame, unsigned char codeType, cons
 		   x = -14 + ((B - 56) % 29)
 		   y =   8 + ((B - 56) / 29)
 		*/
-		relFar(*(*pData)++, 1, &x, &y);
+		{
+			const auto &pos = lookup_table.far_p[*(*pData)++];
+			x = pos.x;
+			y = pos.y;
+		}
 		copyFrame(*pFrame, *pFrame + x + y*g_width);
 		*pFrame += 8;
 		--*pDataRemain;
@@ -266,7 +303,11 @@ static void dispatchDecoder(unsigned char **pFrame, unsigned char codeType, cons
 		   x = -(-14 + ((B - 56) % 29))
 		   y = -(  8 + ((B - 56) / 29))
 		*/
-		relFar(*(*pData)++, -1, &x, &y);
+		{
+			const auto &pos = lookup_table.far_n[*(*pData)++];
+			x = pos.x;
+			y = pos.y;
+		}
 		copyFrame(*pFrame, *pFrame + x + y*g_width);
 		*pFrame += 8;
 		--*pDataRemain;
@@ -286,7 +327,11 @@ static void dispatchDecoder(unsigned char **pFrame, unsigned char codeType, cons
 		   x = -8 + BL
 		   y = -8 + BH
 		*/
-		relClose(*(*pData)++, &x, &y);
+		{
+			const auto &pos = lookup_table.close[*(*pData)++];
+			x = pos.x;
+			y = pos.y;
+		}
 		copyFrame(*pFrame, *pFrame + (g_vBackBuf2 - g_vBackBuf1) + x + y*g_width);
 		*pFrame += 8;
 		--*pDataRemain;
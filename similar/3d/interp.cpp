@@ -68,12 +68,6 @@ static inline int16_t w(const uint8_t *p)
 	return *wp(p);
 }
 
-static void rotate_point_list(g3s_point *dest, const vms_vector *src, uint_fast32_t n)
-{
-	while (n--)
-		g3_rotate_point(*dest++,*src++);
-}
-
 constexpr vms_angvec zero_angles = {0,0,0};
 
 namespace {
@@ -199,7 +193,7 @@ protected:
 private:
 	void rotate(uint_fast32_t i, const vms_vector *const src, const uint_fast32_t n)
 	{
-		rotate_point_list(&Interp_point_list[i], src, n);
+		g3_rotate_point_list(&Interp_point_list[i], src, n);
 	}
 	void set_color_by_model_light(fix g3s_lrgb::*const c, g3s_lrgb &o, const fix color) const
 	{
@@ -1080,7 +1080,7 @@ void save_screen_shot(int automap_flag)
 	pause_game_world_time p;
 
 	if (!PHYSFSX_exists(SCRNS_DIR,0))
-		PHYSFS_mkdir(SCRNS_DIR); //try making directory
+		PHYSFSX_mkdir(SCRNS_DIR); //try making directory
 
 	do
 	{
@@ -66,6 +66,7 @@
 #include "partial_range.h"
 
 #include <algorithm>
+#include <bitset>
 using std::max;
 
 //change to 1 for lots of spew.
@@ -125,7 +126,19 @@ static array<std::unique_ptr<GLfloat[]>, 3> secondary_lva;
 static int r_polyc,r_tpolyc,r_bitmapc,r_ubitbltc;
 #define f2glf(x) (f2fl(x))
 
-#define OGL_BINDTEXTURE(a) glBindTexture(GL_TEXTURE_2D, a);
+static GLuint ogl_bound_texture;	//handle last bound to GL_TEXTURE_2D
+
+//model and wall polygons usually share their texture with the previous
+//polygon, so skip the bind when nothing would change
+static void ogl_bindtexture(const GLuint handle)
+{
+	if (ogl_bound_texture == handle)
+		return;
+	ogl_bound_texture = handle;
+	glBindTexture(GL_TEXTURE_2D, handle);
+}
+
+#define OGL_BINDTEXTURE(a) ogl_bindtexture(a);
 
 static array<ogl_texture, OGL_TEXTURE_LIST_SIZE> ogl_texture_list;
 static int ogl_texture_list_cur;
@@ -242,6 +255,7 @@ static void ogl_reset_texture_stats_internal(void){
 
 void ogl_init_texture_list_internal(void){
 	ogl_texture_list_cur=0;
+	ogl_bound_texture = 0;
 	range_for (auto &i, ogl_texture_list)
 		ogl_reset_texture(i);
 }
@@ -251,6 +265,7 @@ void ogl_smash_texture_list_internal(void){
 	circle_va.reset();
 	disk_va.reset();
 	secondary_lva = {};
+	ogl_bound_texture = 0;
 	range_for (auto &i, ogl_texture_list)
 	{
 		if (i.handle>0){
@@ -411,6 +426,9 @@ namespace dsx {
 void ogl_cache_level_textures(void)
 {
 	int max_efx=0,ef;
+	//	Textures whose bitmap is changed by do_special_effects.  Only sides
+	//	using one of these need to be revisited after the first pass.
+	std::bitset<MAX_TEXTURES> animated_textures;
 	
 	ogl_reset_texture_stats_internal();//loading a new lev should reset textures
 	
@@ -419,6 +437,8 @@ void ogl_cache_level_textures(void)
 		ogl_cache_vclipn_textures(ec.dest_vclip);
 		if ((ec.changing_wall_texture == -1) && (ec.changing_object_texture==-1) )
 			continue;
+		if (ec.changing_wall_texture != -1)
+			animated_textures.set(ec.changing_wall_texture);
 		if (ec.vc.num_frames>max_efx)
 			max_efx=ec.vc.num_frames;
 	}
@@ -443,6 +463,8 @@ void ogl_cache_level_textures(void)
 					//				tmap1=0;
 					continue;
 				}
+				if (ef && !animated_textures[tmap1] && !(tmap2 != 0 && animated_textures[tmap2 & 0x3FFF]))
+					continue;
 				PIGGY_PAGE_IN(Textures[tmap1]);
 				grs_bitmap *bm = &GameBitmaps[Textures[tmap1].index];
 				if (tmap2 != 0){
@@ -861,10 +883,8 @@ void _g3_draw_poly(uint_fast32_t nv,const g3s_point *const *const pointlist, con
 		GLfloat r, g, b, a;
 	};
 	static_assert(sizeof(cfloat) == sizeof(GLfloat) * 4, "cfloat size wrong");
-	RAIIdmem<GLfloat[]> vertex_array, color_array;
-
-	MALLOC(vertex_array, GLfloat[], nv*3);
-	MALLOC(color_array, GLfloat[], nv*4);
+	array<vfloat, MAX_POINTS_PER_POLY> varray;
+	array<cfloat, MAX_POINTS_PER_POLY> carray;
 
 	r_polyc++;
 	ogl_client_states<int, GL_VERTEX_ARRAY, GL_COLOR_ARRAY> cs;
@@ -875,8 +895,6 @@ void _g3_draw_poly(uint_fast32_t nv,const g3s_point *const *const pointlist, con
 		? 1.0
 		: 1.0 - static_cast<float>(grd_curcanv->cv_fade_level) / (static_cast<float>(GR_FADE_LEVELS) - 1.0);
 
-	vfloat *const varray = reinterpret_cast<vfloat *>(vertex_array.get());
-	cfloat *const carray = reinterpret_cast<cfloat *>(color_array.get());
 	for (unsigned c=0; c < nv; ++c)
 	{
 		carray[c].r = color_r;
@@ -889,8 +907,8 @@ void _g3_draw_poly(uint_fast32_t nv,const g3s_point *const *const pointlist, con
 		varray[c].z = -f2glf(p.z);
 	}
 
-	glVertexPointer(3, GL_FLOAT, 0, vertex_array.get());
-	glColorPointer(4, GL_FLOAT, 0, color_array.get());
+	glVertexPointer(3, GL_FLOAT, 0, varray.data());
+	glColorPointer(4, GL_FLOAT, 0, carray.data());
 	glDrawArrays(GL_TRIANGLE_FAN, 0, nv);
 }
 
@@ -921,10 +939,9 @@ void _g3_draw_tmap(unsigned nv, cg3s_point *const *const pointlist, const g3s_uv
 		return;
 	}
 
-	RAIIdmem<GLfloat[]> vertex_array, color_array, texcoord_array;
-	MALLOC(vertex_array, GLfloat[], nv*3);
-	MALLOC(color_array, GLfloat[], nv*4);
-	MALLOC(texcoord_array, GLfloat[], nv*2);
+	array<GLfloat, MAX_POINTS_PER_POLY * 3> vertex_array;
+	array<GLfloat, MAX_POINTS_PER_POLY * 4> color_array;
+	array<GLfloat, MAX_POINTS_PER_POLY * 2> texcoord_array;
 
 	for (c=0; c<nv; c++) {
 		index2 = c * 2;
@@ -950,10 +967,10 @@ void _g3_draw_tmap(unsigned nv, cg3s_point *const *const pointlist, const g3s_uv
 		texcoord_array[index2+1] = f2glf(uvl_list[c].v);
 	}
 	
-	glVertexPointer(3, GL_FLOAT, 0, vertex_array.get());
-	glColorPointer(4, GL_FLOAT, 0, color_array.get());
+	glVertexPointer(3, GL_FLOAT, 0, vertex_array.data());
+	glColorPointer(4, GL_FLOAT, 0, color_array.data());
 	if (tmap_drawer_ptr == draw_tmap) {
-		glTexCoordPointer(2, GL_FLOAT, 0, texcoord_array.get());  
+		glTexCoordPointer(2, GL_FLOAT, 0, texcoord_array.data());  
 	}
 	
 	glDrawArrays(GL_TRIANGLE_FAN, 0, nv);
@@ -972,10 +989,9 @@ void _g3_draw_tmap_2(unsigned nv, const g3s_point *const *const pointlist, const
 {
 	int index2, index3, index4;
 
-	RAIIdmem<GLfloat[]> vertex_array, color_array, texcoord_array;
-	MALLOC(vertex_array, GLfloat[], nv*3);
-	MALLOC(color_array, GLfloat[], nv*4);
-	MALLOC(texcoord_array, GLfloat[], nv*2);
+	array<GLfloat, MAX_POINTS_PER_POLY * 3> vertex_array;
+	array<GLfloat, MAX_POINTS_PER_POLY * 4> color_array;
+	array<GLfloat, MAX_POINTS_PER_POLY * 2> texcoord_array;
 
 	_g3_draw_tmap(nv,pointlist,uvl_list,light_rgb,*bmbot);//draw the bottom texture first.. could be optimized with multitexturing..
 	
@@ -1021,9 +1037,9 @@ void _g3_draw_tmap_2(unsigned nv, const g3s_point *const *const pointlist, const
 		vertex_array[index3+2]   = -f2glf(pointlist[c]->p3_vec.z);
 	}
 	
-	glVertexPointer(3, GL_FLOAT, 0, vertex_array.get());
-	glColorPointer(4, GL_FLOAT, 0, color_array.get());
-	glTexCoordPointer(2, GL_FLOAT, 0, texcoord_array.get());  
+	glVertexPointer(3, GL_FLOAT, 0, vertex_array.data());
+	glColorPointer(4, GL_FLOAT, 0, color_array.data());
+	glTexCoordPointer(2, GL_FLOAT, 0, texcoord_array.data());  
 	glDrawArrays(GL_TRIANGLE_FAN, 0, nv);
 }
 
@@ -1801,6 +1817,8 @@ static void ogl_freetexture(ogl_texture &gltexture)
 		r_texcount--;
 		glmprintf((0,"ogl_freetexture(%p):%i (%i left)\n",&gltexture,gltexture.handle,r_texcount));
 		glDeleteTextures( 1, &gltexture.handle );
+		if (ogl_bound_texture == gltexture.handle)
+			ogl_bound_texture = 0;	//deleting the bound texture reverts the binding to 0
 //		gltexture->handle=0;
 		ogl_reset_texture(gltexture);
 	}
@@ -60,6 +60,7 @@ struct sound_function_table_t
 	int  (*is_channel_playing)(int);
 	void (*stop_all_channels)();
 	void (*set_digi_volume)(int);
+	void (*preload_sound)(short);
 };
 
 #if DXX_USE_SDLMIXER
@@ -77,6 +78,7 @@ constexpr sound_function_table_t digi_mixer_table{
 	&digi_mixer_is_channel_playing,
 	&digi_mixer_stop_all_channels,
 	&digi_mixer_set_digi_volume,
+	&digi_mixer_preload_sound,
 };
 #endif
 
@@ -94,6 +96,7 @@ constexpr sound_function_table_t digi_audio_table{
 	&digi_audio_is_channel_playing,
 	&digi_audio_stop_all_channels,
 	&digi_audio_set_digi_volume,
+	&digi_audio_preload_sound,
 };
 
 class sound_function_pointers_t
@@ -209,6 +212,7 @@ void digi_end_sound(int channel) { fptr->end_sound(channel); }
 int  digi_is_channel_playing(int channel) { return fptr->is_channel_playing(channel); }
 void digi_stop_all_channels() { fptr->stop_all_channels(); }
 void digi_set_digi_volume(int dvolume) { fptr->set_digi_volume(dvolume); }
+void digi_preload_sound(short soundnum) { fptr->preload_sound(soundnum); }
 
 #ifdef _WIN32
 // Windows native-MIDI stuff.
@@ -204,6 +204,9 @@ int digi_audio_init()
 /* Toggle audio */
 void digi_audio_reset() { }
 
+/* Samples are mixed straight from GameSounds, so there is nothing to prepare */
+void digi_audio_preload_sound(short) { }
+
 /* Shut down audio */
 void digi_audio_close()
 {
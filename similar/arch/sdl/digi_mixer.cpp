@@ -62,13 +62,25 @@ struct RAIIMix_Chunk : public Mix_Chunk
 	}
 };
 
+struct mixer_channel
+{
+	uint8_t playing;
+	uint8_t persistent;	// Must not be taken over by another sound
+	fix volume;		// Volume the sound was started or last set at
+};
+
 }
 
 static int digi_initialised = 0;
 static int digi_mixer_max_channels = MAX_SOUND_SLOTS;
 static inline int fix2byte(fix f) { return (f / 256) % 256; }
 static array<RAIIMix_Chunk, MAX_SOUNDS> SoundChunks;
-static array<uint8_t, MAX_SOUND_SLOTS> channels;
+/* Written by the Mix_ChannelFinished callback on the audio thread, so
+ * every other access must hold SDL_LockAudio.
+ */
+static array<mixer_channel, MAX_SOUND_SLOTS> channels;
+
+static void digi_mixer_free_channel(int channel_num);
 
 /* Initialise audio */
 int digi_mixer_init()
@@ -90,7 +102,10 @@ int digi_mixer_init()
 	}
 
 	digi_mixer_max_channels = Mix_AllocateChannels(digi_mixer_max_channels);
+	SDL_LockAudio();
 	channels = {};
+	SDL_UnlockAudio();
+	Mix_ChannelFinished(digi_mixer_free_channel);
 	Mix_Pause(0);
 
 	digi_initialised = 1;
@@ -108,18 +123,37 @@ void digi_mixer_close() {
 	Mix_CloseAudio();
 }
 
-/* channel management */
-static int digi_mixer_find_channel()
+/* channel management; the caller must hold SDL_LockAudio */
+static int digi_mixer_find_channel(const fix volume)
 {
+	int quietest = -1;
 	for (int i = 0; i < digi_mixer_max_channels; i++)
-		if (channels[i] == 0)
+	{
+		auto &c = channels[i];
+		if (!c.playing)
 			return i;
-	return -1;
+		if (c.persistent)
+			continue;
+		if (quietest < 0 || c.volume < channels[quietest].volume)
+			quietest = i;
+	}
+	/* Every channel is busy.  Rather than dropping the new sound, take
+	 * over the quietest channel which may be interrupted, provided the
+	 * new sound is louder.
+	 */
+	if (quietest < 0 || channels[quietest].volume >= volume)
+		return -1;
+	Mix_HaltChannel(quietest);
+	channels[quietest] = {};
+	if (SoundQ_channel == quietest)
+		SoundQ_end();
+	return quietest;
 }
 
+//	Called by SDL_mixer from the audio callback, which holds the audio lock
 static void digi_mixer_free_channel(int channel_num)
 {
-	channels[channel_num] = 0;
+	channels[channel_num] = {};
 }
 
 /*
@@ -165,8 +199,21 @@ static void mixdigi_convert_sound(int i)
 	}
 }
 
+/*
+ * Convert a sound before its first use, so that starting it during play
+ * does not have to.
+ */
+void digi_mixer_preload_sound(short soundnum)
+{
+	if (!digi_initialised)
+		return;
+	if (GameSounds[soundnum].data == reinterpret_cast<void *>(-1))
+		return;
+	mixdigi_convert_sound(soundnum);
+}
+
 // Volume 0-F1_0
-int digi_mixer_start_sound(short soundnum, fix volume, int pan, int looping, int loop_start, int loop_end, sound_object *)
+int digi_mixer_start_sound(short soundnum, fix volume, int pan, int looping, int loop_start, int loop_end, sound_object *const soundobj)
 {
 	int mix_vol = fix2byte(fixmul(digi_volume, volume));
 	int mix_pan = fix2byte(pan);
@@ -184,9 +231,13 @@ int digi_mixer_start_sound(short soundnum, fix volume, int pan, int looping, int
 
 	if (MIX_DIGI_DEBUG) con_printf(CON_DEBUG,"digi_start_sound %d, volume %d, pan %d (start=%d, end=%d)", soundnum, mix_vol, mix_pan, loop_start, loop_end);
 
-	channel = digi_mixer_find_channel();
+	SDL_LockAudio();
+	channel = digi_mixer_find_channel(volume);
 	if (channel < 0)
+	{
+		SDL_UnlockAudio();
 		return -1;
+	}
 
 	Mix_PlayChannel(channel, &(SoundChunks[soundnum]), mix_loop);
 	Mix_SetPanning(channel, 255-mix_pan, mix_pan);
@@ -194,8 +245,11 @@ int digi_mixer_start_sound(short soundnum, fix volume, int pan, int looping, int
 		Mix_SetDistance(channel, 0);
 	else
 		Mix_SetDistance(channel, 255-mix_vol);
-	channels[channel] = 1;
-	Mix_ChannelFinished(digi_mixer_free_channel);
+	auto &c = channels[channel];
+	c.playing = 1;
+	c.persistent = soundobj || looping || volume > F1_0;
+	c.volume = volume;
+	SDL_UnlockAudio();
 
 	return channel;
 }
@@ -204,6 +258,9 @@ void digi_mixer_set_channel_volume(int channel, int volume)
 {
 	int mix_vol = fix2byte(volume);
 	if (!digi_initialised) return;
+	SDL_LockAudio();
+	channels[channel].volume = volume;
+	SDL_UnlockAudio();
 	Mix_SetDistance(channel, 255-mix_vol);
 }
 
@@ -216,14 +273,15 @@ void digi_mixer_set_channel_pan(int channel, int pan)
 void digi_mixer_stop_sound(int channel) {
 	if (!digi_initialised) return;
 	if (MIX_DIGI_DEBUG) con_printf(CON_DEBUG,"digi_stop_sound %d", channel);
+	SDL_LockAudio();
 	Mix_HaltChannel(channel);
-	channels[channel] = 0;
+	channels[channel] = {};
+	SDL_UnlockAudio();
 }
 
 void digi_mixer_end_sound(int channel)
 {
 	digi_mixer_stop_sound(channel);
-	channels[channel] = 0;
 }
 
 void digi_mixer_set_digi_volume( int dvolume )
@@ -238,8 +296,10 @@ int digi_mixer_is_channel_playing(int) { return 0; }
 void digi_mixer_reset() {}
 void digi_mixer_stop_all_channels()
 {
-	channels = {};
+	SDL_LockAudio();
 	Mix_HaltChannel(-1);
+	channels = {};
+	SDL_UnlockAudio();
 }
 
 }
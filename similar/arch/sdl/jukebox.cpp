@@ -252,7 +252,7 @@ void jukebox_load()
 		public:
 			void operator()(const char *const p) const noexcept
 			{
-				PHYSFS_removeFromSearchPath(p);
+				PHYSFSX_removeFromSearchPath(p);
 			}
 		};
 		std::unique_ptr<const char, PHYSFS_path_deleter> new_path;
@@ -275,7 +275,7 @@ void jukebox_load()
 		{
 			if (PHYSFSX_isNewPath(p))
 				new_path.reset(p);
-			PHYSFS_addToSearchPath(p, 0);
+			PHYSFSX_addToSearchPath(p, 0);
 
 			// as mountpoints are no option (yet), make sure only files originating from GameCfg.CMLevelMusicPath are aded to the list.
 			JukeboxSongs.list.reset(PHYSFSX_findabsoluteFiles("", p, jukebox_exts));
@@ -25,7 +25,6 @@ COPYRIGHT 1993-1999 PARALLAX SOFTWARE CORPORATION.  ALL RIGHTS RESERVED.
 
 #include <stdio.h>		//	for printf()
 #include <stdlib.h>		// for d_rand() and qsort()
-#include <string.h>		// for memset()
 
 #include "inferno.h"
 #include "console.h"
@@ -301,11 +300,7 @@ if ((objp->type == OBJ_ROBOT) && (objp->ctype.ai_info.behavior == ai_behavior::A
 
 	l_num_points = 0;
 
-//	for (i=0; i<=Highest_segment_index; i++) {
-//		depth[i] = 0;
-//	}
 	visited_segment_bitarray_t visited;
-	memset(depth, 0, sizeof(depth[0])*(Highest_segment_index+1));
 
 	//	If there is a segment we're not allowed to visit, mark it.
 	if (avoid_seg != segment_none) {
@@ -313,7 +313,7 @@ void con_init(void)
 {
 	con_buffer = {};
 	if (CGameArg.DbgSafelog)
-		gamelog_fp.reset(PHYSFS_openWrite("gamelog.txt"));
+		gamelog_fp = PHYSFSX_openWrite("gamelog.txt");
 	else
 		gamelog_fp = PHYSFSX_openWriteBuffered("gamelog.txt");
 
@@ -44,9 +44,13 @@ COPYRIGHT 1993-1999 PARALLAX SOFTWARE CORPORATION.  ALL RIGHTS RESERVED.
 #include "text.h"
 #include "kconfig.h"
 #include "config.h"
+#include "robot.h"
+#include "weapon.h"
+#include "effects.h"
 
 #include "compiler-begin.h"
 #include "compiler-range_for.h"
+#include "partial_range.h"
 
 using std::max;
 
@@ -137,7 +141,136 @@ static int digi_unxlat_sound(int soundno)
 	throw std::invalid_argument("sound not loaded");
 }
 
-static void digi_get_sound_loc(const vms_matrix &listener, const vms_vector &listener_pos, const vcsegptridx_t listener_seg, const vms_vector &sound_pos, const vcsegptridx_t sound_seg, fix max_volume, int *volume, int *pan, vm_distance max_distance)
+namespace {
+
+//	Same limit as find_connected_distance applies to max_depth
+constexpr unsigned MAX_SOUND_PATH_DEPTH = 62;
+
+/* Segment paths from the listener, shared by all sounds updated in one
+ * digi_sync_sounds pass instead of running find_connected_distance once
+ * per sound.  The breadth first search visits segments in the same order
+ * as find_connected_distance, so each sound gets the same path, the same
+ * distance and the same depth cutoff as its own search would have.
+ */
+class sound_path_field
+{
+	segnum_t listener_seg;
+	unsigned built_depth;
+	visited_segment_bitarray_t reached;
+	array<uint8_t, MAX_SEGMENTS> depth;
+	//	Order in which segments were reached; the listener is 0
+	array<unsigned, MAX_SEGMENTS> order;
+	array<segnum_t, MAX_SEGMENTS> parent, first_hop;
+	array<vms_vector, MAX_SEGMENTS> center;
+	//	Center to center distance from first_hop to this segment
+	array<vm_distance, MAX_SEGMENTS> path_length;
+	//	Order of the first segment whose expansion reached a given depth
+	array<unsigned, MAX_SOUND_PATH_DEPTH + 1> depth_expander;
+	array<segnum_t, MAX_SEGMENTS> queue;
+	void build(vcsegptridx_t seg, unsigned max_depth);
+public:
+	unsigned wanted_depth;
+	void invalidate()
+	{
+		listener_seg = segment_none;
+		wanted_depth = 1;
+	}
+	vm_distance distance(const vms_vector &listener_pos, vcsegptridx_t listener_segp, const vms_vector &sound_pos, vcsegptridx_t sound_segp, unsigned max_depth);
+};
+
+sound_path_field Sound_paths;
+
+void sound_path_field::build(const vcsegptridx_t seg, const unsigned max_depth)
+{
+	listener_seg = seg;
+	built_depth = max_depth;
+	reached.clear();
+	depth_expander.fill(UINT_MAX);
+	reached[seg] = true;
+	depth[seg] = 0;
+	order[seg] = 0;
+	first_hop[seg] = seg;
+	path_length[seg] = vm_distance::minimum_value();
+	compute_segment_center(center[seg], seg);
+	unsigned qhead = 0, qtail = 0;
+	for (segnum_t cur_seg = seg;;)
+	{
+		const unsigned cur_depth = depth[cur_seg];
+		if (cur_depth < max_depth)
+		{
+			const auto &&segp = vcsegptr(cur_seg);
+			for (int sidenum = 0; sidenum < MAX_SIDES_PER_SEGMENT; sidenum++)
+			{
+				const auto this_seg = segp->children[sidenum];
+				if (!IS_CHILD(this_seg))
+					continue;
+				if (!(WALL_IS_DOORWAY(segp, sidenum) & (WID_RENDPAST_FLAG|WID_FLY_FLAG)))
+					continue;
+				if (reached[this_seg])
+					continue;
+				reached[this_seg] = true;
+				const unsigned d = cur_depth + 1;
+				if (depth_expander[d] == UINT_MAX)
+					depth_expander[d] = order[cur_seg];
+				depth[this_seg] = d;
+				order[this_seg] = ++qtail;
+				parent[this_seg] = cur_seg;
+				compute_segment_center(center[this_seg], vcsegptr(this_seg));
+				if (d == 1)
+				{
+					first_hop[this_seg] = this_seg;
+					path_length[this_seg] = vm_distance::minimum_value();
+				}
+				else
+				{
+					first_hop[this_seg] = first_hop[cur_seg];
+					path_length[this_seg] = path_length[cur_seg] + vm_vec_dist_quick(center[this_seg], center[cur_seg]);
+				}
+				queue[qtail - 1] = this_seg;
+			}
+		}
+		if (qhead >= qtail)
+			break;
+		cur_seg = queue[qhead++];
+	}
+}
+
+vm_distance sound_path_field::distance(const vms_vector &listener_pos, const vcsegptridx_t listener_segp, const vms_vector &sound_pos, const vcsegptridx_t sound_segp, unsigned max_depth)
+{
+	if (max_depth > MAX_SOUND_PATH_DEPTH)
+		max_depth = MAX_SOUND_PATH_DEPTH;
+	//	Trivial cases, handled first as in find_connected_distance
+	if (listener_segp == sound_segp)
+		return vm_vec_dist_quick(listener_pos, sound_pos);
+	{
+		const auto conn_side = find_connect_side(listener_segp, sound_segp);
+		if (conn_side != side_none)
+		{
+#if defined(DXX_BUILD_DESCENT_II)
+			if (WALL_IS_DOORWAY(sound_segp, conn_side) & (WID_RENDPAST_FLAG|WID_FLY_FLAG))
+#endif
+				return vm_vec_dist_quick(listener_pos, sound_pos);
+		}
+	}
+	if (listener_seg != listener_segp || built_depth < max_depth)
+		build(listener_segp, std::min(std::max(max_depth, wanted_depth), MAX_SOUND_PATH_DEPTH));
+	const segnum_t t = sound_segp;
+	/* find_connected_distance gives up as soon as any segment at
+	 * max_depth is reached, so a target reached later than that is out of
+	 * range even if it is shallower.
+	 */
+	if (!reached[t] || depth[t] >= max_depth || order[t] > depth_expander[max_depth])
+		return vm_distance::maximum_value();
+	const auto p = parent[t];
+	auto dist = vm_vec_dist_quick(sound_pos, center[p]);
+	dist += vm_vec_dist_quick(listener_pos, center[first_hop[t]]);
+	dist += path_length[p];
+	return dist;
+}
+
+}
+
+static void digi_get_sound_loc(const vms_matrix &listener, const vms_vector &listener_pos, const vcsegptridx_t listener_seg, const vms_vector &sound_pos, const vcsegptridx_t sound_seg, fix max_volume, int *volume, int *pan, vm_distance max_distance, sound_path_field *const paths = nullptr)
 {
 
 	vms_vector	vector_to_sound;
@@ -154,7 +287,9 @@ static void digi_get_sound_loc(const vms_matrix &listener, const vms_vector &lis
 		int num_search_segs = f2i(max_distance/20);
 		if ( num_search_segs < 1 ) num_search_segs = 1;
 
-		auto path_distance = find_connected_distance(listener_pos, listener_seg, sound_pos, sound_seg, num_search_segs, WID_RENDPAST_FLAG|WID_FLY_FLAG);
+		auto path_distance = paths
+			? paths->distance(listener_pos, listener_seg, sound_pos, sound_seg, num_search_segs)
+			: find_connected_distance(listener_pos, listener_seg, sound_pos, sound_seg, num_search_segs, WID_RENDPAST_FLAG|WID_FLY_FLAG);
 		if ( path_distance > -1 )	{
 			*volume = max_volume - fixdiv(path_distance,max_distance);
 			if (*volume > 0 )	{
@@ -231,6 +366,47 @@ void digi_init_sounds()
 	N_active_sound_objects = 0;
 }
 
+//	Prepare the sounds a level is most likely to play: wall effects, the
+//	robots placed in it, their weapons and the player's weapons.  Any other
+//	sound is still prepared on first use.
+void digi_preload_level_sounds()
+{
+	const auto preload = [](const int soundnum) {
+		if (static_cast<unsigned>(soundnum) >= Sounds.size())
+			return;
+		const auto s = digi_xlat_sound(soundnum);
+		if (s >= 0)
+			digi_preload_sound(s);
+	};
+	const auto preload_weapon = [preload](const weapon_info &w) {
+		preload(w.flash_sound);
+		preload(w.robot_hit_sound);
+		preload(w.wall_hit_sound);
+	};
+	range_for (auto &ec, partial_const_range(Effects, Num_effects))
+		preload(ec.sound_num);
+	range_for (const auto w, Primary_weapon_to_weapon_info)
+		preload_weapon(Weapon_info[w]);
+	range_for (const auto w, Secondary_weapon_to_weapon_info)
+		preload_weapon(Weapon_info[w]);
+	range_for (const auto &&objp, vcobjptr)
+	{
+		if (objp->type != OBJ_ROBOT)
+			continue;
+		auto &ri = Robot_info[get_robot_id(objp)];
+		preload(ri.see_sound);
+		preload(ri.attack_sound);
+		preload(ri.claw_sound);
+		preload(ri.exp1_sound_num);
+		preload(ri.exp2_sound_num);
+#if defined(DXX_BUILD_DESCENT_II)
+		preload(ri.taunt_sound);
+		preload(ri.deathroll_sound);
+#endif
+		preload_weapon(Weapon_info[ri.weapon_type]);
+	}
+}
+
 // plays a sample that loops forever.
 // Call digi_stop_channe(channel) to stop it.
 // Call digi_set_channel_volume(channel, volume) to change volume.
@@ -536,6 +712,18 @@ void digi_sync_sounds()
 	if (!Viewer)
 		return;
 	const auto &&viewer = vcobjptr(Viewer);
+	//	Walls may have opened or closed since the last pass, so always
+	//	search again, deep enough for the farthest reaching sound.
+	Sound_paths.invalidate();
+	range_for (auto &s, SoundObjects)
+	{
+		if (s.flags & SOF_USED)
+		{
+			const unsigned num_search_segs = f2i(((s.max_distance * 5) / 4) / 20);
+			if (Sound_paths.wanted_depth < num_search_segs)
+				Sound_paths.wanted_depth = num_search_segs;
+		}
+	}
 	range_for (auto &s, SoundObjects)
 	{
 		if (s.flags & SOF_USED)
@@ -557,7 +745,7 @@ void digi_sync_sounds()
 
 			if ( s.flags & SOF_LINK_TO_POS )	{
 				digi_get_sound_loc(viewer->orient, viewer->pos, vcsegptridx(viewer->segnum), s.link_type.pos.position, vcsegptridx(s.link_type.pos.segnum), s.max_volume,
-                                &s.volume, &s.pan, s.max_distance );
+                                &s.volume, &s.pan, s.max_distance, &Sound_paths);
 
 			} else if ( s.flags & SOF_LINK_TO_OBJ )	{
 				const auto objp = [&s]{
@@ -582,7 +770,7 @@ void digi_sync_sounds()
 					continue;		// Go on to next sound...
 				} else {
 					digi_get_sound_loc(viewer->orient, viewer->pos, vcsegptridx(viewer->segnum), objp->pos, vcsegptridx(objp->segnum), s.max_volume,
-                                   &s.volume, &s.pan, s.max_distance );
+                                   &s.volume, &s.pan, s.max_distance, &Sound_paths);
 				}
 			}
 
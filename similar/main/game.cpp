@@ -465,13 +465,58 @@ void reset_time()
 
 }
 
+// -simbench: ticks run so far and the time the first one started
+static unsigned sim_benchmark_ticks;
+static fix64 sim_benchmark_start;
+
+static uint32_t sim_benchmark_state_hash()
+{
+	uint32_t h = 2166136261u;
+	const auto mix = [&h](const int32_t v) {
+		for (unsigned i = 0; i != 32; i += 8)
+		{
+			h ^= static_cast<uint8_t>(v >> i);
+			h *= 16777619u;
+		}
+	};
+	const auto mix_vector = [&mix](const vms_vector &v) {
+		mix(v.x);
+		mix(v.y);
+		mix(v.z);
+	};
+	range_for (const auto &&objp, vcobjptr)
+	{
+		if (objp->type == OBJ_NONE)
+			continue;
+		mix(objp->type);
+		mix(objp->id);
+		mix(objp->segnum);
+		mix_vector(objp->pos);
+		mix_vector(objp->orient.fvec);
+		mix_vector(objp->orient.uvec);
+		mix(objp->shields);
+	}
+	return h;
+}
+
+static void sim_benchmark_report()
+{
+	const auto seconds = static_cast<double>(timer_query() - sim_benchmark_start) / F1_0;
+	con_printf(CON_URGENT, "simbench: {\"ticks\":%u,\"seconds\":%.3f,\"ticks_per_second\":%.2f,\"state_hash\":\"%08x\"}",
+		sim_benchmark_ticks, seconds, seconds > 0 ? sim_benchmark_ticks / seconds : 0.0, sim_benchmark_state_hash());
+	CGameArg.DbgSimBenchmarkTicks = 0;
+	sim_benchmark_ticks = 0;
+}
+
 void calc_frame_time()
 {
 	fix last_frametime = FrameTime;
 
 	const auto vsync = CGameCfg.VSync;
-	const auto bound = f1_0 / (likely(vsync) ? MAXIMUM_FPS : CGameArg.SysMaxFPS);
-	const auto may_sleep = !CGameArg.SysNoNiceFPS && !vsync;
+	const auto timedemo = newdemo_timedemo_active();
+	const auto simbench = CGameArg.DbgSimBenchmarkTicks && Newdemo_state != ND_STATE_PLAYBACK;
+	const auto bound = (timedemo || simbench) ? 0 : f1_0 / (likely(vsync) ? MAXIMUM_FPS : CGameArg.SysMaxFPS);
+	const auto may_sleep = !CGameArg.SysNoNiceFPS && !vsync && !timedemo && !simbench;
 	for (;;)
 	{
 		const auto timer_value = timer_update();
@@ -487,6 +532,20 @@ void calc_frame_time()
 			timer_delay_ms(1);
 	}
 
+	if (timedemo)
+		FrameTime = newdemo_timedemo_frame(FrameTime);
+	else if (simbench)
+	{
+		// Fixed ticks and a fixed seed, so that runs of the same level
+		// produce the same world state hash.
+		if (!sim_benchmark_ticks++)
+		{
+			sim_benchmark_start = timer_query();
+			d_srand(1);
+		}
+		FrameTime = F1_0 / 30;
+	}
+
 	if ( cheats.turbo )
 		FrameTime *= 2;
 
@@ -528,7 +587,7 @@ void save_screen_shot(int automap_flag)
 	pause_game_world_time p;
 
 	if (!PHYSFSX_exists(SCRNS_DIR,0))
-		PHYSFS_mkdir(SCRNS_DIR); //try making directory
+		PHYSFSX_mkdir(SCRNS_DIR); //try making directory
 
 	save_canv = grd_curcanv;
 	auto temp_canv = gr_create_canvas(screen_canv->cv_bitmap.bm_w,screen_canv->cv_bitmap.bm_h);
@@ -1268,6 +1327,12 @@ window_event_result game_handler(window *,const d_event &event, const unused_win
 			{
 				calc_frame_time();
 				GameProcessFrame();
+				if (sim_benchmark_ticks && sim_benchmark_ticks >= CGameArg.DbgSimBenchmarkTicks)
+				{
+					sim_benchmark_report();
+					Quitting = 1;
+					return window_event_result::close;
+				}
 			}
 
 			if (!Automap_active)		// efficiency hack
@@ -1281,6 +1346,12 @@ window_event_result game_handler(window *,const d_event &event, const unused_win
 			break;
 
 		case EVENT_WINDOW_CLOSE:
+			if (sim_benchmark_ticks)
+			{
+				//game ended before the requested number of ticks
+				sim_benchmark_report();
+				Quitting = 1;
+			}
 			digi_stop_digi_sounds();
 
 			if ( (Newdemo_state == ND_STATE_RECORDING) || (Newdemo_state == ND_STATE_PAUSED) )
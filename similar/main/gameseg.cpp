@@ -27,7 +27,6 @@ COPYRIGHT 1993-1999 PARALLAX SOFTWARE CORPORATION.  ALL RIGHTS RESERVED.
 #include <cassert>
 #include <stdlib.h>
 #include <stdio.h>
-#include <string.h>	//	for memset()
 
 #include "u_mem.h"
 #include "inferno.h"
@@ -836,7 +835,6 @@ vm_distance find_connected_distance(const vms_vector &p0, const vcsegptridx_t se
 	num_points = 0;
 
 	visited_segment_bitarray_t visited;
-	memset(depth, 0, sizeof(depth[0]) * (Highest_segment_index+1));
 
 	cur_seg = seg0;
 	visited[cur_seg] = true;
@@ -1151,6 +1149,7 @@ void extract_up_vector_from_segment(const vcsegptr_t sp,vms_vector &vp)
 	extract_vector_from_segment(sp,vp,WBOTTOM,WTOP);
 }
 
+#if DXX_USE_EDITOR
 //	----
 //	A side is determined to be degenerate if the cross products of 3 consecutive points does not point outward.
 static int check_for_degenerate_side(const vcsegptr_t sp, int sidenum)
@@ -1222,13 +1221,12 @@ static int check_for_degenerate_segment(const vcsegptr_t sp)
 	for (i=0; i<MAX_SIDES_PER_SEGMENT; i++)
 		degeneracy_flag |= check_for_degenerate_side(sp, i);
 
-#if DXX_USE_EDITOR
 	Degenerate_segment_found |= degeneracy_flag;
-#endif
 
 	return degeneracy_flag;
 
 }
+#endif
 
 static void add_side_as_quad(const vsegptr_t sp, int sidenum, const vms_vector &normal)
 {
@@ -1477,7 +1475,12 @@ void validate_segment_side(const vsegptridx_t sp, int sidenum)
 //		create new vector normals
 void validate_segment(const vsegptridx_t sp)
 {
+#if DXX_USE_EDITOR
+	/* The result only feeds the editor's degenerate segment warning, so
+	 * skip the normalizations when loading levels for play.
+	 */
 	check_for_degenerate_segment(sp);
+#endif
 
 	for (int side = 0; side < MAX_SIDES_PER_SEGMENT; side++)
 		validate_segment_side(sp, side);
@@ -761,6 +761,10 @@ void LoadLevel(int level_num,int page_in_textures)
 
 	save_player = get_local_player();
 
+#ifdef DEBUG_MEMORY_ALLOCATIONS
+	if (CGameArg.DbgShowMemInfo)
+		mem_display_sites();
+#endif
 	Assert(level_num <= Last_level  && level_num >= Last_secret_level  && level_num != 0);
 	const d_fname &level_name = get_level_file(level_num);
 #if defined(DXX_BUILD_DESCENT_I)
@@ -1684,6 +1688,7 @@ void StartNewLevelSub(const int level_num, const int page_in_textures, const sec
 #if DXX_USE_OGL
 	ogl_cache_level_textures();
 #endif
+	digi_preload_level_sounds();
 
 
 	if (Network_rejoined == 1)
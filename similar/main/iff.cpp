@@ -899,7 +899,7 @@ int iff_write_bitmap(const char *ofilename,grs_bitmap *bm,palette_array_t *palet
 
 	//open file and write
 
-	RAIIPHYSFS_File ofile{PHYSFS_openWrite(ofilename)};
+	auto ofile = PHYSFSX_openWrite(ofilename);
 	if (!ofile)
 		return IFF_NO_FILE;
 
@@ -168,6 +168,7 @@ static void print_commandline_help()
 	VERB("  -auto-record-demo             Start recording on level entry\n")	\
 	VERB("  -record-demo-format           Set demo name automatically\n")	\
 	VERB("  -autodemo                     Start in demo mode\n")	\
+	VERB("  -timedemo <s>                 Play demo <s> unthrottled, report frame times and quit\n")	\
 	VERB("  -window                       Run the game in a window\n")	\
 	VERB("  -noborders                    Don't show borders in window mode\n")	\
 	DXX_COMMAND_LINE_HELP_D1(	\
@@ -237,11 +238,16 @@ static void print_commandline_help()
 	VERB("  -norun                        Bail out after initialization\n")	\
 	VERB("  -no-grab                      Never grab keyboard/mouse\n")	\
 	VERB("  -renderstats                  Enable renderstats info by default\n")	\
+	VERB("  -simbench <n>                 Run the next game for <n> fixed-length ticks unthrottled,\n\t\t\t\treport tick rate and world state hash, and quit\n")	\
 	VERB("  -text <s>                     Specify alternate .tex file\n")	\
 	VERB("  -showmeminfo                  Show memory statistics\n")	\
 	VERB("  -nodoublebuffer               Disable Doublebuffering\n")	\
 	VERB("  -bigpig                       Use uncompressed RLE bitmaps\n")	\
 	VERB("  -16bpp                        Use 16Bpp instead of 32Bpp\n")	\
+	DXX_if_defined_01(DXX_USE_UDP, (	\
+		VERB("  -udp_trafficlog <s>           Write per-packet-type UDP traffic totals to CSV file <s>\n")	\
+		VERB("  -udp_capture <s>              Record received UDP packets to capture file <s>\n")	\
+	))	\
 	DXX_COMMAND_LINE_HELP_OGL(	\
 		VERB("  -gl_oldtexmerge               Use old texmerge, uses more ram, but might be faster\n")	\
 		VERB("  -gl_intensity4_ok <n>         Override DbgGlIntensity4Ok (default: 1)\n")	\
@@ -86,9 +86,29 @@ static void add_light_dot_square(g3s_lrgb &d, const g3s_lrgb &light, const fix &
 	d.b += fixmul(square, light.b)/8;
 }
 
+namespace {
+
+//bounding box of the vertices in the render list
+struct render_vertex_bounds
+{
+	vms_vector min, max;
+};
+
+}
+
+//distance along the longest axis from pos to the box.  Both the quick
+//distance and the connected distance are at least this large.
+static int64_t render_vertex_bounds_distance(const render_vertex_bounds &b, const vms_vector &pos)
+{
+	const auto axis = [](const fix lo, const fix hi, const fix p) -> int64_t {
+		return p < lo ? static_cast<int64_t>(lo) - p : (p > hi ? static_cast<int64_t>(p) - hi : 0);
+	};
+	return std::max({axis(b.min.x, b.max.x, pos.x), axis(b.min.y, b.max.y, pos.y), axis(b.min.z, b.max.z, pos.z)});
+}
+
 // ----------------------------------------------------------------------------------------------
 namespace dsx {
-static void apply_light(g3s_lrgb obj_light_emission, const vcsegptridx_t obj_seg, const vms_vector &obj_pos, int n_render_vertices, array<int, MAX_VERTICES> &render_vertices, const array<segnum_t, MAX_VERTICES> &vert_segnum_list, objnum_t objnum)
+static void apply_light(g3s_lrgb obj_light_emission, const vcsegptridx_t obj_seg, const vms_vector &obj_pos, int n_render_vertices, array<int, MAX_VERTICES> &render_vertices, const array<segnum_t, MAX_VERTICES> &vert_segnum_list, const render_vertex_bounds &render_bounds, objnum_t objnum)
 {
 	if (((obj_light_emission.r+obj_light_emission.g+obj_light_emission.b)/3) > 0)
 	{
@@ -152,6 +172,10 @@ static void apply_light(g3s_lrgb obj_light_emission, const vcsegptridx_t obj_seg
 					}
 			}
 #endif
+			//	A source too far from every rendered vertex lights none of them.
+			//	Allow F1_0 for rounding in the connected distance.
+			if (render_vertex_bounds_distance(render_bounds, obj_pos) >= (static_cast<int64_t>(abs(obji_64)) << headlight_shift) + F1_0)
+				return;
 			for (int vv=0; vv<n_render_vertices; vv++) {
 				int			vertnum;
 				fix			dist;
@@ -219,7 +243,7 @@ static void apply_light(g3s_lrgb obj_light_emission, const vcsegptridx_t obj_seg
 #define FLASH_SCALE             (3*F1_0/FLASH_LEN_FIXED_SECONDS)
 
 // ----------------------------------------------------------------------------------------------
-static void cast_muzzle_flash_light(int n_render_vertices, array<int, MAX_VERTICES> &render_vertices, const array<segnum_t, MAX_VERTICES> &vert_segnum_list)
+static void cast_muzzle_flash_light(int n_render_vertices, array<int, MAX_VERTICES> &render_vertices, const array<segnum_t, MAX_VERTICES> &vert_segnum_list, const render_vertex_bounds &render_bounds)
 {
 	fix64 current_time;
 	short time_since_flash;
@@ -235,7 +259,7 @@ static void cast_muzzle_flash_light(int n_render_vertices, array<int, MAX_VERTIC
 			{
 				g3s_lrgb ml;
 				ml.r = ml.g = ml.b = ((FLASH_LEN_FIXED_SECONDS - time_since_flash) * FLASH_SCALE);
-				apply_light(ml, vsegptridx(i.segnum), i.pos, n_render_vertices, render_vertices, vert_segnum_list, object_none);
+				apply_light(ml, vsegptridx(i.segnum), i.pos, n_render_vertices, render_vertices, vert_segnum_list, render_bounds, object_none);
 			}
 			else
 			{
@@ -501,6 +525,10 @@ void set_dynamic_light(render_state_t &rstate)
 
 	//	Create list of vertices that need to be looked at for setting of ambient light.
 	uint_fast32_t n_render_vertices = 0;
+	render_vertex_bounds render_bounds{
+		{INT32_MAX, INT32_MAX, INT32_MAX},
+		{INT32_MIN, INT32_MIN, INT32_MIN}
+	};
 	range_for (const auto segnum, partial_const_range(rstate.Render_list, rstate.N_render_segs))
 	{
 		if (segnum != segment_none) {
@@ -519,19 +547,26 @@ void set_dynamic_light(render_state_t &rstate)
 					vert_segnum_list[n_render_vertices] = segnum;
 					n_render_vertices++;
 					Dynamic_light[vnum] = {};
+					const auto &v = Vertices[vnum];
+					render_bounds.min.x = std::min(render_bounds.min.x, v.x);
+					render_bounds.min.y = std::min(render_bounds.min.y, v.y);
+					render_bounds.min.z = std::min(render_bounds.min.z, v.z);
+					render_bounds.max.x = std::max(render_bounds.max.x, v.x);
+					render_bounds.max.y = std::max(render_bounds.max.y, v.y);
+					render_bounds.max.z = std::max(render_bounds.max.z, v.z);
 				}
 			}
 		}
 	}
 
-	cast_muzzle_flash_light(n_render_vertices, render_vertices, vert_segnum_list);
+	cast_muzzle_flash_light(n_render_vertices, render_vertices, vert_segnum_list, render_bounds);
 
 	range_for (const auto &&obj, vobjptridx)
 	{
 		const auto &&obj_light_emission = compute_light_emission(obj);
 
 		if (((obj_light_emission.r+obj_light_emission.g+obj_light_emission.b)/3) > 0)
-			apply_light(obj_light_emission, vsegptridx(obj->segnum), obj->pos, n_render_vertices, render_vertices, vert_segnum_list, obj);
+			apply_light(obj_light_emission, vsegptridx(obj->segnum), obj->pos, n_render_vertices, render_vertices, vert_segnum_list, render_bounds, obj);
 	}
 }
 
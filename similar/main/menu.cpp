@@ -461,6 +461,13 @@ static int main_menu_handler(newmenu *menu,const d_event &event, int *menu_choic
 			break;
 
 		case EVENT_IDLE:
+			if (!CGameArg.SysTimeDemo.empty())
+			{
+				const std::string timedemo = std::move(CGameArg.SysTimeDemo);
+				CGameArg.SysTimeDemo.clear();
+				newdemo_start_timedemo(timedemo.c_str());
+				break;
+			}
 #if defined(DXX_BUILD_DESCENT_I)
 #define DXX_DEMO_KEY_DELAY	45
 #elif defined(DXX_BUILD_DESCENT_II)
@@ -1769,7 +1776,7 @@ static int select_file_handler(listbox *menu,const d_event &event, browser *b)
 		}
 		case EVENT_WINDOW_CLOSE:
 			if (b->new_path)
-				PHYSFS_removeFromSearchPath(b->view_path);
+				PHYSFSX_removeFromSearchPath(b->view_path);
 
 			std::default_delete<browser>()(b);
 			break;
@@ -1830,7 +1837,7 @@ static int select_file_recursive2(const char *title, const char *orig_path, cons
 
 		p = b->view_path + strlen(b->view_path) - 1;
 		const size_t len_sep = strlen(sep);
-		while (b->new_path = PHYSFSX_isNewPath(b->view_path), !PHYSFS_addToSearchPath(b->view_path, 0))
+		while (b->new_path = PHYSFSX_isNewPath(b->view_path), !PHYSFSX_addToSearchPath(b->view_path, 0))
 		{
 			while ((p > b->view_path) && strncmp(p, sep, len_sep))
 				p--;
@@ -1847,7 +1854,7 @@ static int select_file_recursive2(const char *title, const char *orig_path, cons
 		strncpy(b->view_path, PHYSFS_getUserDir(), PATH_MAX - 1);
 		b->view_path[PATH_MAX - 1] = '\0';
 		b->new_path = PHYSFSX_isNewPath(b->view_path);
-		if (!PHYSFS_addToSearchPath(b->view_path, 0))
+		if (!PHYSFSX_addToSearchPath(b->view_path, 0))
 		{
 			return 0;
 		}
@@ -13,6 +13,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <inttypes.h>
 
 #include "pstypes.h"
 #include "window.h"
@@ -58,6 +59,7 @@
 #include "config.h"
 #include "vers_id.h"
 #include "u_mem.h"
+#include "physfsx.h"
 
 #include "dxxsconf.h"
 #include "compiler-array.h"
@@ -124,6 +126,33 @@ static int net_udp_start_game(void);
 
 // Variables
 static int UDP_num_sendto, UDP_len_sendto, UDP_num_recvfrom, UDP_len_recvfrom;
+
+namespace {
+
+struct udp_traffic_counter
+{
+	unsigned packets;
+	uint64_t bytes;
+	void count(const ssize_t len)
+	{
+		++packets;
+		bytes += len;
+	}
+};
+
+/* Totals since the program started, indexed by the UPID_* byte which
+ * leads every packet.  CGameArg.DbgUdpTrafficLog is rewritten with them
+ * each time the sockets are closed.
+ */
+struct udp_traffic_by_type
+{
+	array<udp_traffic_counter, 256> in, out;
+};
+
+}
+
+static udp_traffic_by_type UDP_traffic;
+static RAIIPHYSFS_File UDP_capture_file;
 static UDP_mdata_info		UDP_MData;
 static UDP_sequence_packet UDP_Seq;
 static unsigned UDP_mdata_queue_highest;
@@ -508,7 +537,10 @@ ssize_t dxx_sendto_t::apply(int sockfd, const void *msg, size_t len, int flags,
 
 	UDP_num_sendto++;
 	if (rv > 0)
+	{
 		UDP_len_sendto += rv;
+		UDP_traffic.out[*reinterpret_cast<const uint8_t *>(msg)].count(rv);
+	}
 
 	return rv;
 }
@@ -519,6 +551,8 @@ ssize_t dxx_recvfrom_t::apply(int sockfd, void *buf, size_t len, int flags, sock
 
 	UDP_num_recvfrom++;
 	UDP_len_recvfrom += rv;
+	if (rv > 0)
+		UDP_traffic.in[*reinterpret_cast<const uint8_t *>(buf)].count(rv);
 
 	return rv;
 }
@@ -540,6 +574,62 @@ static void udp_traffic_stat()
 	}
 }
 
+static void udp_traffic_write_log()
+{
+	if (CGameArg.DbgUdpTrafficLog.empty())
+		return;
+	auto fp = PHYSFSX_openWriteBuffered(CGameArg.DbgUdpTrafficLog.c_str());
+	if (!fp)
+	{
+		con_printf(CON_URGENT, "Cannot write UDP traffic log \"%s\": %s", CGameArg.DbgUdpTrafficLog.c_str(), PHYSFS_getLastError());
+		return;
+	}
+	PHYSFSX_puts_literal(fp, "direction,upid,packets,bytes\n");
+	const auto write_direction = [&fp](const char *const direction, const array<udp_traffic_counter, 256> &counters) {
+		for (unsigned upid = 0; upid != counters.size(); ++upid)
+		{
+			auto &c = counters[upid];
+			if (c.packets)
+				PHYSFSX_printf(fp, "%s,%u,%u,%" PRIu64 "\n", direction, upid, c.packets, c.bytes);
+		}
+	};
+	write_direction("in", UDP_traffic.in);
+	write_direction("out", UDP_traffic.out);
+}
+
+/* Capture file layout, all values little endian:
+ *	char[4] "DUCP", uint16 version
+ * followed by one record per received datagram:
+ *	int64 timer_query() at receipt, uint8 socket index, uint16 length,
+ *	length bytes of packet data
+ */
+//	Opened by the first net_udp_init and kept until the program exits
+static void udp_capture_open()
+{
+	static bool opened;
+	if (opened)
+		return;
+	opened = true;
+	if (CGameArg.DbgUdpCapture.empty())
+		return;
+	UDP_capture_file = PHYSFSX_openWriteBuffered(CGameArg.DbgUdpCapture.c_str());
+	if (!UDP_capture_file)
+	{
+		con_printf(CON_URGENT, "Cannot open UDP capture file \"%s\": %s", CGameArg.DbgUdpCapture.c_str(), PHYSFS_getLastError());
+		return;
+	}
+	PHYSFS_write(UDP_capture_file, "DUCP", 4, 1);
+	PHYSFS_writeULE16(UDP_capture_file, 1);
+}
+
+static void udp_capture_packet(const unsigned sockidx, const uint8_t *const data, const unsigned len)
+{
+	PHYSFS_writeSLE64(UDP_capture_file, timer_query());
+	PHYSFSX_writeU8(UDP_capture_file, sockidx);
+	PHYSFS_writeULE16(UDP_capture_file, len);
+	PHYSFS_write(UDP_capture_file, data, len, 1);
+}
+
 namespace {
 
 class udp_dns_filladdr_t
@@ -1304,6 +1394,7 @@ void net_udp_init()
 #endif
 
 	UDP_Socket = {};
+	udp_capture_open();
 
 	Netgame = {};
 	UDP_Seq = {};
@@ -1326,6 +1417,9 @@ void net_udp_init()
 void net_udp_close()
 {
 	UDP_Socket = {};
+	udp_traffic_write_log();
+	if (UDP_capture_file)
+		PHYSFS_flush(UDP_capture_file);
 #ifdef _WIN32
 	WSACleanup();
 #endif
@@ -1836,16 +1930,15 @@ static void net_udp_stop_resync(UDP_sequence_packet *their)
 }
 
 namespace dsx {
-void net_udp_send_objects(void)
+
+/* Fill and send one UPID_OBJECT_DATA packet.  Returns true if there are
+ * more objects to send to UDP_sync_player.
+ */
+static bool net_udp_send_object_packet()
 {
 	sbyte owner, player_num = UDP_sync_player.player.connected;
 	static int obj_count = 0;
 	int loc = 0, remote_objnum = 0, obj_count_frame = 0;
-	static fix64 last_send_time = 0;
-	
-	if (last_send_time + (F1_0/50) > timer_query())
-		return;
-	last_send_time = timer_query();
 
 	// Send clear objects array trigger and send player num
 
@@ -1859,7 +1952,7 @@ void net_udp_send_objects(void)
 		// have to stop and try again after the level.
 		net_udp_dump_player(UDP_sync_player.player.protocol.udp.addr, DUMP_ENDLEVEL);
 		Network_send_objects = 0; 
-		return;
+		return false;
 	}
 
 	array<uint8_t, UPID_MAX_SIZE> object_buffer;
@@ -1958,9 +2051,27 @@ void net_udp_send_objects(void)
 #endif
 			VerifyPlayerJoined = Player_joining_extras = player_num;
 
-			return;
+			return false;
 		} // mode == 1;
 	} // i > Highest_object_index
+	return true;
+}
+
+void net_udp_send_objects(void)
+{
+	static fix64 last_send_time = 0;
+	
+	if (last_send_time + (F1_0/50) > timer_query())
+		return;
+	last_send_time = timer_query();
+
+	/* Send a burst of packets per tick instead of a single one, so a
+	 * rejoining player receives the object table in a fraction of the
+	 * time.  The wire format is unchanged.
+	 */
+	for (unsigned n = UDP_OBJ_PACKETS_PER_FRAME; n--;)
+		if (!net_udp_send_object_packet())
+			break;
 }
 }
 
@@ -4580,7 +4691,7 @@ void net_udp_flush()
 		net_udp_flush(s);
 }
 
-static void net_udp_listen(RAIIsocket &sock)
+static void net_udp_listen(RAIIsocket &sock, const unsigned sockidx)
 {
 	if (!sock)
 		return;
@@ -4591,14 +4702,16 @@ static void net_udp_listen(RAIIsocket &sock)
 		const int size = udp_receive_packet(sock, packet.data(), packet.size(), &sender_addr);
 		if (!(size > 0))
 			break;
+		if (UDP_capture_file)
+			udp_capture_packet(sockidx, packet.data(), size);
 		net_udp_process_packet(packet.data(), sender_addr, size);
 	}
 }
 
 void net_udp_listen()
 {
-	range_for (auto &s, UDP_Socket)
-		net_udp_listen(s);
+	for (unsigned i = 0; i != UDP_Socket.size(); ++i)
+		net_udp_listen(UDP_Socket[i], i);
 }
 
 void net_udp_send_data(const ubyte * ptr, int len, int priority )
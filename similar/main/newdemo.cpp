@@ -23,8 +23,10 @@ COPYRIGHT 1993-1999 PARALLAX SOFTWARE CORPORATION.  ALL RIGHTS RESERVED.
  *
  */
 
+#include <algorithm>
 #include <cstdlib>
 #include <ctime>
+#include <vector>
 #include <stdio.h>
 #include <stdarg.h>
 #include <errno.h>
@@ -87,6 +89,7 @@ COPYRIGHT 1993-1999 PARALLAX SOFTWARE CORPORATION.  ALL RIGHTS RESERVED.
 #include "console.h"
 #include "controls.h"
 #include "playsave.h"
+#include "timer.h"
 
 #if DXX_USE_EDITOR
 #include "editor/editor.h"
@@ -161,6 +164,9 @@ COPYRIGHT 1993-1999 PARALLAX SOFTWARE CORPORATION.  ALL RIGHTS RESERVED.
 #define SKIP_PLAYBACK				1
 #define INTERPOLATE_PLAYBACK			2
 #define INTERPOL_FACTOR				(F1_0 + (F1_0/5))
+#define ND_SCRUB_FRAMES				10	// rewind/fast forward always step this many frames per displayed frame
+#define ND_SCRUB_SPEED				32	// and go on until this many times the displayed frame time of demo is covered
+#define ND_SCRUB_TIME_LIMIT			(F1_0/20)	// or this much wall clock time has passed
 
 #if defined(DXX_BUILD_DESCENT_I)
 #define DEMO_VERSION_SHAREWARE		5
@@ -209,6 +215,11 @@ static int nd_playback_v_framecount;
 static fix nd_playback_total, nd_recorded_total, nd_recorded_time;
 static sbyte nd_playback_v_style;
 static ubyte nd_playback_v_dead = 0, nd_playback_v_rear = 0;
+
+// -timedemo: wall clock time taken by each played frame, reported when
+// the demo ends
+static bool nd_timedemo_active;
+static std::vector<fix> nd_timedemo_frame_times;
 #if defined(DXX_BUILD_DESCENT_II)
 static ubyte nd_playback_v_guided = 0;
 int nd_playback_v_juststarted=0;
@@ -303,12 +314,29 @@ static typename tt::enable_if<tt::is_integral<T>::value, int>::type newdemo_read
 	return _newdemo_read(buffer, elsize, nelem);
 }
 
+/* Direct-mapped cache of signature to object number for
+ * newdemo_find_object.  Entries are validated on every lookup, so slots
+ * which were freed or reused since they were cached fall back to the
+ * full scan without needing invalidation from the object allocator.
+ */
+static array<objnum_t, 1024> nd_playback_v_signature_cache;
+
 cobjptridx_t newdemo_find_object(object_signature_t signature)
 {
+	auto &cached = nd_playback_v_signature_cache[signature.get() % nd_playback_v_signature_cache.size()];
+	if (cached < Objects.get_count())
+	{
+		const auto &&objp = vcobjptridx(cached);
+		if (objp->type != OBJ_NONE && objp->signature == signature)
+			return objp;
+	}
 	range_for (const auto &&objp, vcobjptridx)
 	{
 		if ( (objp->type != OBJ_NONE) && (objp->signature == signature))
+		{
+			cached = objp;
 			return objp;
+		}
 	}
 	return object_none;
 }
@@ -3433,6 +3461,12 @@ void newdemo_goto_end(int to_rewrite)
 }
 }
 
+//	Recorded length of the frame just read, or a 30 fps frame if none was recorded
+static fix nd_frame_recorded_time()
+{
+	return nd_recorded_time > 0 ? nd_recorded_time : F1_0 / 30;
+}
+
 static void newdemo_back_frames(int frames)
 {
 	short last_frame_length;
@@ -3493,52 +3527,50 @@ static void interpolate_frame(fix d_play, fix d_recorded)
 	if (InterpolStep <= 0)
 	{
 		range_for (auto &i, partial_range(cur_objs, num_cur_objs)) {
-			range_for (const auto &&objp, vobjptr)
-			{
-				if (i.signature == objp->signature) {
-					sbyte render_type = i.render_type;
-					fix delta_x, delta_y, delta_z;
-
-					//  Extract the angles from the object orientation matrix.
-					//  Some of this code taken from ai_turn_towards_vector
-					//  Don't do the interpolation on certain render types which don't use an orientation matrix
-
-					if (!((render_type == RT_LASER) || (render_type == RT_FIREBALL) || (render_type == RT_POWERUP))) {
-						vms_vector  fvec1, fvec2, rvec1, rvec2;
-						fix         mag1;
-
-						fvec1 = i.orient.fvec;
-						vm_vec_scale(fvec1, F1_0-factor);
-						fvec2 = objp->orient.fvec;
-						vm_vec_scale(fvec2, factor);
-						vm_vec_add2(fvec1, fvec2);
-						mag1 = vm_vec_normalize_quick(fvec1);
-						if (mag1 > F1_0/256) {
-							rvec1 = i.orient.rvec;
-							vm_vec_scale(rvec1, F1_0-factor);
-							rvec2 = objp->orient.rvec;
-							vm_vec_scale(rvec2, factor);
-							vm_vec_add2(rvec1, rvec2);
-							vm_vec_normalize_quick(rvec1); // Note: Doesn't matter if this is null, if null, vm_vector_2_matrix will just use fvec1
-							vm_vector_2_matrix(i.orient, fvec1, nullptr, &rvec1);
-						}
+			const auto &&objp = newdemo_find_object(i.signature);
+			if (objp != object_none) {
+				sbyte render_type = i.render_type;
+				fix delta_x, delta_y, delta_z;
+
+				//  Extract the angles from the object orientation matrix.
+				//  Some of this code taken from ai_turn_towards_vector
+				//  Don't do the interpolation on certain render types which don't use an orientation matrix
+
+				if (!((render_type == RT_LASER) || (render_type == RT_FIREBALL) || (render_type == RT_POWERUP))) {
+					vms_vector  fvec1, fvec2, rvec1, rvec2;
+					fix         mag1;
+
+					fvec1 = i.orient.fvec;
+					vm_vec_scale(fvec1, F1_0-factor);
+					fvec2 = objp->orient.fvec;
+					vm_vec_scale(fvec2, factor);
+					vm_vec_add2(fvec1, fvec2);
+					mag1 = vm_vec_normalize_quick(fvec1);
+					if (mag1 > F1_0/256) {
+						rvec1 = i.orient.rvec;
+						vm_vec_scale(rvec1, F1_0-factor);
+						rvec2 = objp->orient.rvec;
+						vm_vec_scale(rvec2, factor);
+						vm_vec_add2(rvec1, rvec2);
+						vm_vec_normalize_quick(rvec1); // Note: Doesn't matter if this is null, if null, vm_vector_2_matrix will just use fvec1
+						vm_vector_2_matrix(i.orient, fvec1, nullptr, &rvec1);
 					}
+				}
 
-					// Interpolate the object position.  This is just straight linear
-					// interpolation.
+				// Interpolate the object position.  This is just straight linear
+				// interpolation.
 
-					delta_x = objp->pos.x - i.pos.x;
-					delta_y = objp->pos.y - i.pos.y;
-					delta_z = objp->pos.z - i.pos.z;
+				delta_x = objp->pos.x - i.pos.x;
+				delta_y = objp->pos.y - i.pos.y;
+				delta_z = objp->pos.z - i.pos.z;
 
-					delta_x = fixmul(delta_x, factor);
-					delta_y = fixmul(delta_y, factor);
-					delta_z = fixmul(delta_z, factor);
+				delta_x = fixmul(delta_x, factor);
+				delta_y = fixmul(delta_y, factor);
+				delta_z = fixmul(delta_z, factor);
 
-					i.pos.x += delta_x;
-					i.pos.y += delta_y;
-					i.pos.z += delta_z;
-				}
+				i.pos.x += delta_x;
+				i.pos.y += delta_y;
+				i.pos.z += delta_z;
 			}
 		}
 		InterpolStep = fl2f(.01);
@@ -3561,7 +3593,6 @@ static void interpolate_frame(fix d_play, fix d_recorded)
 
 void newdemo_playback_one_frame()
 {
-	int frames_back;
 	static fix base_interpol_time = 0;
 	static fix d_recorded = 0;
 
@@ -3587,18 +3618,26 @@ void newdemo_playback_one_frame()
 		const int level = Current_level_num;
 		if (nd_playback_v_framecount == 0)
 			return;
-		else if ((Newdemo_vcr_state == ND_STATE_REWINDING) && (nd_playback_v_framecount < 10)) {
+		else if ((Newdemo_vcr_state == ND_STATE_REWINDING) && (nd_playback_v_framecount < ND_SCRUB_FRAMES)) {
 			newdemo_goto_beginning();
 			return;
 		}
-		if (Newdemo_vcr_state == ND_STATE_REWINDING)
-			frames_back = 10;
-		else
-			frames_back = 1;
 		if (nd_playback_v_at_eof) {
 			PHYSFS_seek(infile, PHYSFS_tell(infile) + (shareware ? -2 : +11));
 		}
-		newdemo_back_frames(frames_back);
+		if (Newdemo_vcr_state == ND_STATE_REWINDING)
+		{
+			const fix64 scrub_end = timer_query() + ND_SCRUB_TIME_LIMIT;
+			const fix scrub_target = FrameTime * ND_SCRUB_SPEED;
+			fix scrubbed = 0;
+			unsigned stepped = 0;
+			do {
+				newdemo_back_frames(1);
+				scrubbed += nd_frame_recorded_time();
+			} while (Newdemo_state == ND_STATE_PLAYBACK && (++stepped < ND_SCRUB_FRAMES || (level == Current_level_num && nd_playback_v_framecount > ND_SCRUB_FRAMES && scrubbed < scrub_target && timer_query() < scrub_end)));
+		}
+		else
+			newdemo_back_frames(1);
 
 		if (level != Current_level_num)
 			newdemo_pop_ctrlcen_triggers();
@@ -3612,8 +3651,11 @@ void newdemo_playback_one_frame()
 	else if (Newdemo_vcr_state == ND_STATE_FASTFORWARD) {
 		if (!nd_playback_v_at_eof)
 		{
-			for (int i = 0; i < 10; i++)
-			{
+			const fix64 scrub_end = timer_query() + ND_SCRUB_TIME_LIMIT;
+			const fix scrub_target = FrameTime * ND_SCRUB_SPEED;
+			fix scrubbed = 0;
+			unsigned stepped = 0;
+			do {
 				if (newdemo_read_frame_information(0) == -1)
 				{
 					if (nd_playback_v_at_eof)
@@ -3622,7 +3664,8 @@ void newdemo_playback_one_frame()
 						newdemo_stop_playback();
 					break;
 				}
-			}
+				scrubbed += nd_frame_recorded_time();
+			} while (++stepped < ND_SCRUB_FRAMES || (scrubbed < scrub_target && timer_query() < scrub_end));
 		}
 		else
 			Newdemo_vcr_state = ND_STATE_PAUSED;
@@ -3700,13 +3743,11 @@ void newdemo_playback_one_frame()
 					//  interpolated position and orientation can be preserved.
 
 					range_for (auto &i, partial_const_range(cur_objs, 1 + num_objs)) {
-						range_for (const auto &&objp, vobjptr)
-						{
-							if (i.signature == objp->signature) {
-								objp->orient = i.orient;
-								objp->pos = i.pos;
-								break;
-							}
+						const auto &&objp = newdemo_find_object(i.signature);
+						if (objp != object_none) {
+							const auto &&o = vobjptr(static_cast<objnum_t>(objp));
+							o->orient = i.orient;
+							o->pos = i.pos;
 						}
 					}
 					d_recorded += nd_recorded_time;
@@ -3741,7 +3782,7 @@ void newdemo_start_recording()
 	nd_record_v_no_space=0;
 	Newdemo_state = ND_STATE_RECORDING;
 
-	PHYSFS_mkdir(DEMO_DIR); //always try making directory - could only exist in read-only path
+	PHYSFSX_mkdir(DEMO_DIR); //always try making directory - could only exist in read-only path
 
 	outfile = PHYSFSX_openWriteBuffered(DEMO_FILENAME);
 
@@ -4074,9 +4115,71 @@ void newdemo_start_playback(const char * filename)
 
 }
 
+bool newdemo_timedemo_active()
+{
+	return nd_timedemo_active;
+}
+
+fix newdemo_timedemo_frame(const fix elapsed)
+{
+	nd_timedemo_frame_times.emplace_back(elapsed);
+	// Advance the game by the recorded frame time, not the wall clock, so
+	// that every run of a demo plays the same frames.
+	return nd_frame_recorded_time();
+}
+
 namespace dsx {
+
+void newdemo_start_timedemo(const char *const filename)
+{
+	nd_timedemo_frame_times.clear();
+	nd_timedemo_active = true;
+	newdemo_start_playback(filename);
+	if (Newdemo_state != ND_STATE_PLAYBACK)
+	{
+		nd_timedemo_active = false;
+		con_printf(CON_URGENT, "timedemo: cannot play demo \"%s\"", filename);
+		Quitting = 1;
+	}
+}
+
+static void newdemo_timedemo_report()
+{
+	if (!nd_timedemo_active)
+		return;
+	nd_timedemo_active = false;
+	Quitting = 1;
+	auto &t = nd_timedemo_frame_times;
+	// The first frame also pays for loading the level and leaving the
+	// menu, so it is not part of the result.
+	if (t.size() < 2)
+	{
+		con_printf(CON_URGENT, "timedemo: no frames played");
+		return;
+	}
+	t.erase(t.begin());
+	fix64 total = 0;
+	range_for (const auto i, t)
+		total += i;
+	std::sort(t.begin(), t.end());
+	const auto ms = [](const fix64 f) {
+		return static_cast<double>(f) * 1000 / F1_0;
+	};
+	const auto percentile = [&t, ms](const std::size_t p) {
+		return ms(t[(t.size() - 1) * p / 100]);
+	};
+	const std::size_t frames = t.size();
+	const auto seconds = ms(total) / 1000;
+	con_printf(CON_URGENT, "timedemo: {\"frames\":%" DXX_PRI_size_type ",\"seconds\":%.3f,\"fps\":%.2f,\"ms_mean\":%.3f,\"ms_p50\":%.3f,\"ms_p95\":%.3f,\"ms_p99\":%.3f,\"ms_max\":%.3f}",
+		frames, seconds, seconds > 0 ? frames / seconds : 0.0, ms(total) / frames,
+		percentile(50), percentile(95), percentile(99), ms(t.back()));
+	t.clear();
+	t.shrink_to_fit();
+}
+
 void newdemo_stop_playback()
 {
+	newdemo_timedemo_report();
 	infile.reset();
 	Newdemo_state = ND_STATE_NORMAL;
 	change_playernum_to(0);             //this is reality
@@ -25,6 +25,7 @@ COPYRIGHT 1993-1999 PARALLAX SOFTWARE CORPORATION.  ALL RIGHTS RESERVED.
 
 #include <algorithm>
 #include <cstdlib>
+#include <functional>
 #include <stdio.h>
 
 #include "inferno.h"
@@ -98,6 +99,12 @@ object *ConsoleObject;					//the object that is the player
 }
 
 namespace dcx {
+/* free_obj_list[num_objects] through free_obj_list[MAX_OBJECTS - 1] are
+ * the free slots, kept as a min-heap rooted at the end of the array.
+ * obj_allocate always hands out the lowest free slot, so live objects
+ * stay packed at the front and Highest_object_index, which bounds every
+ * per-frame walk over the object array, stays as low as possible.
+ */
 static array<objnum_t, MAX_OBJECTS> free_obj_list;
 
 //Data for objects
@@ -107,6 +114,11 @@ static array<objnum_t, MAX_OBJECTS> free_obj_list;
 //info on the various types of objects
 
 int num_objects=0;
+
+static array<objnum_t, MAX_OBJECTS>::reverse_iterator free_obj_heap_end()
+{
+	return std::next(free_obj_list.rbegin(), MAX_OBJECTS - num_objects);
+}
 }
 
 namespace dsx {
@@ -839,6 +851,7 @@ void init_objects()
 	init_player_object();
 	obj_link(vobjptridx(ConsoleObject), vsegptridx(segment_first));	//put in the world in segment 0
 	num_objects = 1;						//just the player
+	std::make_heap(free_obj_list.rbegin(), free_obj_heap_end(), std::greater<objnum_t>());
 	Objects.set_count(1);
 }
 
@@ -859,6 +872,7 @@ void special_reset_objects(void)
 		else
 			if (i > Highest_object_index)
 				Objects.set_count(i + 1);
+	std::make_heap(free_obj_list.rbegin(), free_obj_heap_end(), std::greater<objnum_t>());
 }
 
 //link the object into the list for its segment
@@ -928,6 +942,7 @@ objptridx_t obj_allocate()
 		return object_none;
 	}
 
+	std::pop_heap(free_obj_list.rbegin(), free_obj_heap_end(), std::greater<objnum_t>());
 	auto objnum = free_obj_list[num_objects++];
 
 	if (objnum > Highest_object_index) {
@@ -943,6 +958,7 @@ static void obj_free(objnum_t objnum)
 {
 	free_obj_list[--num_objects] = objnum;
 	Assert(num_objects >= 0);
+	std::push_heap(free_obj_list.rbegin(), free_obj_heap_end(), std::greater<objnum_t>());
 
 	if (objnum == Highest_object_index)
 	{
@@ -1931,6 +1947,7 @@ void reset_objects(int n_objs)
 		objp->segnum = segment_none;
 	}
 
+	std::make_heap(free_obj_list.rbegin(), free_obj_heap_end(), std::greater<objnum_t>());
 	Objects.set_count(num_objects);
 
 	Debris_object_count = 0;
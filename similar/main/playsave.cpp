@@ -707,7 +707,7 @@ static int write_player_dxx(const char *filename)
 	auto fout = PHYSFSX_openWriteBuffered(tempfile);
 	if (!fout && CGameArg.SysUsePlayersDir)
 	{
-		PHYSFS_mkdir(PLAYER_DIRECTORY_STRING(""));	//try making directory
+		PHYSFSX_mkdir(PLAYER_DIRECTORY_STRING(""));	//try making directory
 		fout=PHYSFSX_openWriteBuffered(tempfile);
 	}
 	
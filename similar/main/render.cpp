@@ -1268,7 +1268,8 @@ static void build_segment_list(render_state_t &rstate, visited_twobit_array_t &v
 	int	lcnt,scnt,ecnt;
 	int	l;
 
-	rstate.render_pos.fill(-1);
+	//only segments up to Highest_segment_index can be reached
+	std::fill_n(rstate.render_pos.begin(), Highest_segment_index + 1, -1);
 
 	#ifndef NDEBUG
 	visited2 = {};
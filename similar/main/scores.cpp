@@ -136,7 +136,7 @@ static void scores_read(all_scores *scores)
 
 static void scores_write(all_scores *scores)
 {
-	RAIIPHYSFS_File fp{PHYSFS_openWrite(SCORES_FILENAME)};
+	auto fp = PHYSFSX_openWrite(SCORES_FILENAME);
 	if (!fp)
 	{
 		nm_messagebox( TXT_WARNING, 1, TXT_OK, "%s\n'%s'", TXT_UNABLE_TO_OPEN, SCORES_FILENAME  );
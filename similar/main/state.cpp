@@ -73,6 +73,7 @@ COPYRIGHT 1993-1999 PARALLAX SOFTWARE CORPORATION.  ALL RIGHTS RESERVED.
 #include "state.h"
 #include "multi.h"
 #include "gr.h"
+#include "ignorecase.h"
 #if DXX_USE_OGL
 #include "ogl_init.h"
 #endif
@@ -583,6 +584,72 @@ struct state_userdata
 	array<grs_bitmap_ptr, NUM_SAVES> sc_bmp;
 };
 
+/* Savegame headers as read when the slot menu was last opened.  An entry
+ * is reused while the file keeps the same modification time, so reopening
+ * the menu does not need to read every slot again.
+ */
+struct state_slot_header
+{
+	std::string filename;
+	PHYSFS_sint64 modtime;
+	bool valid;
+#if defined(DXX_BUILD_DESCENT_II)
+	bool has_palette;
+	palette_array_t palette;
+#endif
+	char desc[DESC_LENGTH + 16];
+	array<uint8_t, THUMBNAIL_W * THUMBNAIL_H> thumbnail;
+};
+
+static array<state_slot_header, NUM_SAVES> state_slot_cache;
+
+}
+
+static void state_read_slot_header(const char *filename, state_slot_header &slot)
+{
+	slot.valid = false;
+	char filename2[PATH_MAX];
+	snprintf(filename2, sizeof(filename2), "%s", filename);
+	PHYSFSEXT_locateCorrectCase(filename2);
+	RAIIPHYSFS_File fp{PHYSFS_openRead(filename2)};
+	if (!fp)
+		return;
+	// Only the header is wanted, so do not buffer the whole file
+	PHYSFS_setBuffer(fp, 4 + sizeof(int) + sizeof(PHYSFS_sint32) + CALLSIGN_LEN + 1 + DESC_LENGTH + slot.thumbnail.size()
+#if defined(DXX_BUILD_DESCENT_II)
+		+ sizeof(slot.palette)
+#endif
+	);
+	char id[4];
+	//Read id
+	PHYSFS_read(fp, id, sizeof(char) * 4, 1);
+	if (memcmp(id, dgss_id, 4))
+		return;
+	//Read version
+	int version;
+	PHYSFS_read(fp, &version, sizeof(int), 1);
+	// In case it's Coop, read state_game_id & callsign as well
+	if (Game_mode & GM_MULTI_COOP)
+		PHYSFS_seek(fp, PHYSFS_tell(fp) + sizeof(PHYSFS_sint32) + CALLSIGN_LEN + 1); // skip state_game_id and callsign
+	if (!((version >= STATE_COMPATIBLE_VERSION) || (SWAPINT(version) >= STATE_COMPATIBLE_VERSION)))
+		return;
+	// Read description
+	PHYSFS_read(fp, slot.desc, sizeof(char) * DESC_LENGTH, 1);
+	// Read thumbnail
+	PHYSFS_read(fp, slot.thumbnail.data(), slot.thumbnail.size(), 1);
+#if defined(DXX_BUILD_DESCENT_II)
+	slot.has_palette = version >= 9;
+	if (slot.has_palette)
+		PHYSFS_read(fp, &slot.palette[0], sizeof(slot.palette[0]), slot.palette.size());
+#endif
+	slot.valid = true;
+}
+
+static void state_invalidate_slot_header(const char *filename)
+{
+	range_for (auto &slot, state_slot_cache)
+		if (slot.filename == filename)
+			slot.filename.clear();
 }
 
 static int state_callback(newmenu *menu,const d_event &event, state_userdata *const userdata)
@@ -653,54 +720,42 @@ namespace dsx {
  */
 static int state_get_savegame_filename(char * fname, char * dsc, const char * caption, blind_save blind)
 {
-	int i, choice, version, nsaves;
+	int i, choice, nsaves;
 	newmenu_item m[NUM_SAVES+1];
 	char filename[NUM_SAVES][PATH_MAX];
 	char desc[NUM_SAVES][DESC_LENGTH + 16];
 	state_userdata userdata;
 	auto &sc_bmp = userdata.sc_bmp;
-	char id[5], dummy_callsign[CALLSIGN_LEN+1];
-	int valid;
 
 	nsaves=0;
 	nm_set_item_text(m[0], "\n\n\n\n");
 	for (i=0;i<NUM_SAVES; i++ )	{
 		snprintf(filename[i], sizeof(filename[i]), PLAYER_DIRECTORY_STRING("%.8s.%cg%x"), static_cast<const char *>(get_local_player().callsign), (Game_mode & GM_MULTI_COOP)?'m':'s', i );
-		valid = 0;
-		if (auto fp = PHYSFSX_openReadBuffered(filename[i]))
+		auto &slot = state_slot_cache[i];
+		const auto modtime = PHYSFS_getLastModTime(filename[i]);
+		if (modtime == -1 || slot.modtime != modtime || slot.filename != filename[i])
 		{
-			//Read id
-			PHYSFS_read(fp, id, sizeof(char) * 4, 1);
-			if ( !memcmp( id, dgss_id, 4 )) {
-				//Read version
-				PHYSFS_read(fp, &version, sizeof(int), 1);
-				// In case it's Coop, read state_game_id & callsign as well
-				if (Game_mode & GM_MULTI_COOP)
-				{
-					PHYSFS_seek(fp, PHYSFS_tell(fp) + sizeof(PHYSFS_sint32)); // skip state_game_id
-					PHYSFS_read(fp, &dummy_callsign, sizeof(char)*CALLSIGN_LEN+1, 1);
-				}
-				if ((version >= STATE_COMPATIBLE_VERSION) || (SWAPINT(version) >= STATE_COMPATIBLE_VERSION)) {
-					// Read description
-					PHYSFS_read(fp, desc[i], sizeof(char) * DESC_LENGTH, 1);
-					//rpad_string( desc[i], DESC_LENGTH-1 );
-					if (dsc == NULL) m[i+1].type = NM_TYPE_MENU;
-					// Read thumbnail
-					sc_bmp[i] = gr_create_bitmap(THUMBNAIL_W,THUMBNAIL_H );
-					PHYSFS_read(fp, sc_bmp[i]->get_bitmap_data(), THUMBNAIL_W * THUMBNAIL_H, 1);
+			state_read_slot_header(filename[i], slot);
+			// Files which could not be stat'ed are read again next time
+			if (modtime == -1)
+				slot.filename.clear();
+			else
+				slot.filename = filename[i];
+			slot.modtime = modtime;
+		}
+		if (slot.valid) {
+			memcpy(desc[i], slot.desc, DESC_LENGTH);
+			//rpad_string( desc[i], DESC_LENGTH-1 );
+			if (dsc == NULL) m[i+1].type = NM_TYPE_MENU;
+			sc_bmp[i] = gr_create_bitmap(THUMBNAIL_W,THUMBNAIL_H );
+			memcpy(sc_bmp[i]->get_bitmap_data(), slot.thumbnail.data(), slot.thumbnail.size());
 #if defined(DXX_BUILD_DESCENT_II)
-					if (version >= 9) {
-						palette_array_t pal;
-						PHYSFS_read(fp, &pal[0], sizeof(pal[0]), pal.size());
-						gr_remap_bitmap_good(*sc_bmp[i].get(), pal, -1, -1);
-					}
+			if (slot.has_palette)
+				gr_remap_bitmap_good(*sc_bmp[i].get(), slot.palette, -1, -1);
 #endif
-					nsaves++;
-					valid = 1;
-				}
-			}
-		} 
-		if (!valid) {
+			nsaves++;
+		}
+		else {
 			strcpy( desc[i], TXT_EMPTY );
 			//rpad_string( desc[i], DESC_LENGTH-1 );
 			if (dsc == NULL) m[i+1].type = NM_TYPE_TEXT;
@@ -760,7 +815,7 @@ static int copy_file(const char *old_file, const char *new_file)
 	RAIIPHYSFS_File in_file{PHYSFS_openRead(old_file)};
 	if (!in_file)
 		return -2;
-	RAIIPHYSFS_File out_file{PHYSFS_openWrite(new_file)};
+	auto out_file = PHYSFSX_openWrite(new_file);
 	if (!out_file)
 		return -1;
 
@@ -904,6 +959,7 @@ int state_save_all_sub(const char *filename, const char *desc)
 		Int3();
 	#endif
 
+	state_invalidate_slot_header(filename);
 	auto fp = PHYSFSX_openWriteBuffered(filename);
 	if ( !fp ) {
 		nm_messagebox(NULL, 1, TXT_OK, "Error writing savegame.\nPossibly out of disk\nspace.");
@@ -952,6 +1008,13 @@ int state_save_all_sub(const char *filename, const char *desc)
  		glReadBuffer(gl_draw_buffer);
 #endif
 		glReadPixels(0, SHEIGHT - THUMBNAIL_H, THUMBNAIL_W, THUMBNAIL_H, GL_RGBA, GL_UNSIGNED_BYTE, buf.get());
+		/* A rendered frame uses few distinct colors, so remember recent
+		 * conversions rather than searching the whole palette for each
+		 * thumbnail pixel.
+		 */
+		array<uint32_t, 1024> cached_rgb;
+		array<color_t, 1024> cached_color;
+		cached_rgb.fill(UINT32_MAX);
 		int k;
 		k = THUMBNAIL_H;
 		for (unsigned i = 0; i < THUMBNAIL_W * THUMBNAIL_H; i++)
@@ -959,8 +1022,15 @@ int state_save_all_sub(const char *filename, const char *desc)
 			int j;
 			if (!(j = i % THUMBNAIL_W))
 				k--;
-			cnv->cv_bitmap.get_bitmap_data()[THUMBNAIL_W * k + j] =
-				gr_find_closest_color(buf[4*i]/4, buf[4*i+1]/4, buf[4*i+2]/4);
+			const unsigned r = buf[4*i]/4, g = buf[4*i+1]/4, b = buf[4*i+2]/4;
+			const uint32_t rgb = (r << 12) | (g << 6) | b;
+			const auto slot = (rgb ^ (rgb >> 8)) % cached_rgb.size();
+			if (cached_rgb[slot] != rgb)
+			{
+				cached_rgb[slot] = rgb;
+				cached_color[slot] = gr_find_closest_color(r, g, b);
+			}
+			cnv->cv_bitmap.get_bitmap_data()[THUMBNAIL_W * k + j] = cached_color[slot];
 		}
 #endif
 		}
@@ -242,6 +242,8 @@ static void ReadCmdArgs(Inilist &ini, Arglist &Args)
 #endif
 		else if (!d_stricmp(p, "-autodemo"))
 			CGameArg.SysAutoDemo = true;
+		else if (!d_stricmp(p, "-timedemo"))
+			CGameArg.SysTimeDemo = arg_string(pp, end);
 
 	// Control Options
 
@@ -328,6 +330,10 @@ static void ReadCmdArgs(Inilist &ini, Arglist &Args)
 		else if (!d_stricmp(p, "-tracker_hostport"))
 			arg_port_number(pp, end, CGameArg.MplTrackerPort, true);
 #endif
+		else if (!d_stricmp(p, "-udp_trafficlog"))
+			CGameArg.DbgUdpTrafficLog = arg_string(pp, end);
+		else if (!d_stricmp(p, "-udp_capture"))
+			CGameArg.DbgUdpCapture = arg_string(pp, end);
 #endif
 
 #if defined(DXX_BUILD_DESCENT_I)
@@ -361,6 +367,8 @@ static void ReadCmdArgs(Inilist &ini, Arglist &Args)
 			CGameArg.DbgNoRun = true;
 		else if (!d_stricmp(p, "-renderstats"))
 			CGameArg.DbgRenderStats = true;
+		else if (!d_stricmp(p, "-simbench"))
+			CGameArg.DbgSimBenchmarkTicks = arg_integer(pp, end);
 		else if (!d_stricmp(p, "-text"))
 			CGameArg.DbgAltTex = arg_string(pp, end);
 		else if (!d_stricmp(p, "-tmap"))
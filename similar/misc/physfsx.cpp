@@ -253,6 +253,7 @@ bool PHYSFSX_init(int argc, char *argv[])
 		PHYSFS_addToSearchPath(base_dir, 1);
 	}
 #endif
+	PHYSFSEXT_invalidateCorrectCase();
 	return true;
 }
 
@@ -260,6 +261,30 @@ bool PHYSFSX_init(int argc, char *argv[])
 
 namespace dcx {
 
+int PHYSFSX_addToSearchPath(const char *newDir, int appendToPath)
+{
+	PHYSFSEXT_invalidateCorrectCase();
+	return PHYSFS_addToSearchPath(newDir, appendToPath);
+}
+
+int PHYSFSX_removeFromSearchPath(const char *oldDir)
+{
+	PHYSFSEXT_invalidateCorrectCase();
+	return PHYSFS_removeFromSearchPath(oldDir);
+}
+
+int PHYSFSX_mkdir(const char *dirName)
+{
+	PHYSFSEXT_invalidateCorrectCase();
+	return PHYSFS_mkdir(dirName);
+}
+
+RAIIPHYSFS_File PHYSFSX_openWrite(const char *filename)
+{
+	PHYSFSEXT_invalidateCorrectCase();
+	return RAIIPHYSFS_File{PHYSFS_openWrite(filename)};
+}
+
 // Add a searchpath, but that searchpath is relative to an existing searchpath
 // It will add the first one it finds and return 1, if it doesn't find any it returns 0
 int PHYSFSX_addRelToSearchPath(const char *relname, int add_to_end)
@@ -274,7 +299,7 @@ int PHYSFSX_addRelToSearchPath(const char *relname, int add_to_end)
 		return 0;
 
 	con_printf(CON_DEBUG, "PHYSFS: %s canonical directory \"%s\" to search path from relative name \"%s\"", add_to_end ? "append" : "set", pathname.data(), relname);
-	return PHYSFS_addToSearchPath(pathname.data(), add_to_end);
+	return PHYSFSX_addToSearchPath(pathname.data(), add_to_end);
 }
 
 int PHYSFSX_removeRelFromSearchPath(const char *relname)
@@ -288,7 +313,7 @@ int PHYSFSX_removeRelFromSearchPath(const char *relname)
 	if (!PHYSFSX_getRealPath(relname2, pathname))
 		return 0;
 
-	return PHYSFS_removeFromSearchPath(pathname.data());
+	return PHYSFSX_removeFromSearchPath(pathname.data());
 }
 
 int PHYSFSX_fsize(const char *hogname)
@@ -444,6 +469,7 @@ int PHYSFSX_rename(const char *oldpath, const char *newpath)
 	array<char, PATH_MAX> old, n;
 	PHYSFSX_getRealPath(oldpath, old);
 	PHYSFSX_getRealPath(newpath, n);
+	PHYSFSEXT_invalidateCorrectCase();
 	return (rename(old.data(), n.data()) == 0);
 }
 
@@ -529,7 +555,7 @@ RAIIPHYSFS_File PHYSFSX_openWriteBuffered(const char *filename)
 {
 	PHYSFS_uint64 bufSize = 1024*1024;	// hmm, seems like an OK size.
 	
-	RAIIPHYSFS_File fp{PHYSFS_openWrite(filename)};
+	auto fp = PHYSFSX_openWrite(filename);
 	if (!fp)
 		return nullptr;
 	while (!PHYSFS_setBuffer(fp, bufSize) && bufSize)
@@ -582,6 +608,7 @@ void PHYSFSX_addArchiveContent()
 
 	if (content_updated)
 	{
+		PHYSFSEXT_invalidateCorrectCase();
 		con_printf(CON_DEBUG, "Game content updated!");
 		PHYSFSX_listSearchPathContent();
 	}
@@ -611,6 +638,7 @@ void PHYSFSX_removeArchiveContent()
 		PHYSFSX_getRealPath(demofile,realfile);
 		PHYSFS_removeFromSearchPath(realfile.data());
 	}
+	PHYSFSEXT_invalidateCorrectCase();
 }
 
 void PHYSFSX_read_helper_report_error(const char *const filename, const unsigned line, const char *const func, PHYSFS_File *const file)